@@ -0,0 +1,170 @@
+// TetraChain.h
+// ------------------------------------------------------------
+// Lecture des ntuples simTetra quel que soit le mode d'écriture :
+//  - ntuples fusionnés par le master (défaut) : l'arbre est dans le fichier de sortie
+//  - ntuples par thread (TETRA_NTUPLE_MERGING=0) : un fichier <sortie>_t<N>.root par
+//    worker, le fichier principal ne contient que les histogrammes et RunMeta
+//    (plus parfois une copie vide des arbres, ignorée au profit des _t*).
+//    La fusion se fait ici, paresseusement, par un TChain sur les fichiers _t*.
+//  - RNTuple (fichier converti par ConvertToRNTuple.C, ROOT >= 6.30) : lu par
+//    TetraReader, même interface de lecture colonne par colonne que le TTree.
+//
+// Usage :
+//   #include "TetraChain.h"
+//   TChain* t = OpenTetraTree("output_PARIS50_scan.root", "resp");
+//
+//   TetraReader r("output_PARIS50_scan_rntuple.root", "resp");   // TTree ou RNTuple
+//   double e = 0; r.Bind("Etrue_keV", &e);
+//   for (Long64_t i = 0; i < r.GetEntries(); ++i) { r.GetEntry(i); ... }
+
+#ifndef TetraChain_h
+#define TetraChain_h
+
+#include <RVersion.h>
+#include <TChain.h>
+#include <TFile.h>
+#include <TKey.h>
+#include <TString.h>
+#include <TSystem.h>
+#include <TTree.h>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,30,0)
+#define TETRA_HAS_RNTUPLE 1
+#if __has_include(<ROOT/RNTupleReader.hxx>)
+#include <ROOT/RNTupleReader.hxx>
+#else
+#include <ROOT/RNTuple.hxx>
+#endif
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,36,0)
+using TetraNTupleReader = ROOT::RNTupleReader;
+#else
+using TetraNTupleReader = ROOT::Experimental::RNTupleReader;
+#endif
+#endif
+
+inline TChain* OpenTetraTree(const char* fileName, const char* treeName)
+{
+  auto* chain = new TChain(treeName);
+
+  // Sans fusion des ntuples, le fichier du master peut contenir une copie
+  // vide de l'arbre réservé : les lignes sont alors dans les _t*.root
+  bool inMain = false;
+  {
+    std::unique_ptr<TFile> f(TFile::Open(fileName, "READ"));
+    TTree* tree = (f && !f->IsZombie()) ? dynamic_cast<TTree*>(f->Get(treeName)) : nullptr;
+    if (tree && tree->GetEntries() > 0) {
+      chain->Add(fileName);
+      return chain;
+    }
+    inMain = (tree != nullptr);
+  }
+
+  // Fichiers par thread : sortie.root -> sortie_t0.root, sortie_t1.root, ...
+  TString pattern(fileName);
+  if (pattern.EndsWith(".root")) pattern.Resize(pattern.Length() - 5);
+  pattern += "_t*.root";
+  const int nFiles = chain->Add(pattern);
+  if (nFiles > 0) {
+    std::cout << "[INFO] " << treeName << " : " << nFiles << " fichiers par thread ("
+              << pattern << ")" << std::endl;
+    return chain;
+  }
+
+  // Arbre réellement vide (aucun évènement écrit)
+  if (inMain) {
+    chain->Add(fileName);
+    return chain;
+  }
+
+  std::cerr << "[ERROR] TTree '" << treeName << "' not found in " << fileName
+            << " nor in " << pattern << std::endl;
+  delete chain;
+  return nullptr;
+}
+
+// ------------------------------------------------------------
+// Lecture TTree (fichier ou _t*.root) ou RNTuple, selon le contenu du fichier.
+// Bind() rend false si la colonne est absente (colonnes optionnelles : weight, ...).
+class TetraReader
+{
+public:
+  TetraReader(const char* fileName, const char* name)
+  {
+    std::unique_ptr<TFile> f(TFile::Open(fileName, "READ"));
+    TKey* key = (f && !f->IsZombie()) ? f->GetKey(name) : nullptr;
+    if (key && TString(key->GetClassName()).Contains("RNTuple")) {
+#ifdef TETRA_HAS_RNTUPLE
+      fNTuple = TetraNTupleReader::Open(name, fileName);
+      std::cout << "[INFO] " << name << " : RNTuple (" << fileName << ")" << std::endl;
+#else
+      std::cerr << "[ERROR] " << name << " est un RNTuple : ROOT >= 6.30 requis" << std::endl;
+#endif
+      return;
+    }
+    fChain.reset(OpenTetraTree(fileName, name));
+    if (fChain) fChain->LoadTree(0);   // SetBranchAddress ne vérifie les branches que sur un arbre chargé
+  }
+
+  bool IsOpen() const { return fChain || IsRNTuple(); }
+
+  bool IsRNTuple() const
+  {
+#ifdef TETRA_HAS_RNTUPLE
+    return fNTuple != nullptr;
+#else
+    return false;
+#endif
+  }
+
+  Long64_t GetEntries() const
+  {
+    if (fChain) return fChain->GetEntries();
+#ifdef TETRA_HAS_RNTUPLE
+    if (fNTuple) return fNTuple->GetNEntries();
+#endif
+    return 0;
+  }
+
+  template <class T>
+  bool Bind(const char* column, T* address)
+  {
+    if (fChain) {
+      return fChain->GetBranch(column) && fChain->SetBranchAddress(column, address) >= 0;
+    }
+#ifdef TETRA_HAS_RNTUPLE
+    if (fNTuple) {
+      try {
+        using View = decltype(fNTuple->GetView<T>(column));
+        auto view = std::make_shared<View>(fNTuple->GetView<T>(column));
+        fLoaders.push_back([view, address](Long64_t i) { *address = (*view)(i); });
+        return true;
+      } catch (const std::exception&) {
+        return false;   // colonne absente ou de type différent
+      }
+    }
+#endif
+    return false;
+  }
+
+  void GetEntry(Long64_t i)
+  {
+    if (fChain) { fChain->GetEntry(i); return; }
+#ifdef TETRA_HAS_RNTUPLE
+    for (auto& load : fLoaders) load(i);
+#endif
+  }
+
+private:
+  std::unique_ptr<TChain> fChain;
+#ifdef TETRA_HAS_RNTUPLE
+  std::unique_ptr<TetraNTupleReader> fNTuple;
+  std::vector<std::function<void(Long64_t)>> fLoaders;
+#endif
+};
+
+#endif
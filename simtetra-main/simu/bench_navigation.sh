@@ -0,0 +1,48 @@
+#!/usr/bin/env bash
+# Navigation benchmark: NORCAN chassis / TETRA shells as nested G4UnionSolid
+# (/detector/legacyBooleans true) versus voxelized G4MultiUnion (default).
+# Usage:
+#   ./bench_navigation.sh [EVENTS] [NTHREADS] [ENERGY_keV]
+# Env overrides:
+#   G4APP=./simTetra   path to executable
+# Output: events/s for each geometry (Real time of the run, /run/verbose 1)
+set -euo pipefail
+EVENTS=${1:-200000}
+NTHREADS=${2:-1}
+ENERGY=${3:-662}
+G4APP=${G4APP:-./simTetra}
+
+run_one() {
+  local legacy="$1"
+  local MAC="tmp_bench_nav_${legacy}.mac"
+  cat > "$MAC" <<EOM
+/control/verbose 0
+/run/verbose 1
+/event/verbose 0
+/tracking/verbose 0
+/run/numberOfThreads ${NTHREADS}
+/random/setSeeds 12345 67890
+/detector/legacyBooleans ${legacy}
+/run/initialize
+/gps/particle gamma
+/gps/pos/type Point
+/gps/pos/centre 0 0 0 mm
+/gps/ang/type iso
+/gps/ene/mono ${ENERGY} keV
+/tetra/output/ntuples false
+/tetra/output/respHistos false
+/run/beamOn ${EVENTS}
+EOM
+  local real
+  real=$(TAG="bench_nav_${legacy}" "$G4APP" "$MAC" 2>&1 | sed -n 's/.*Real=\([0-9.eE+-]*\)s.*/\1/p' | tail -1)
+  rm -f "$MAC" "../../myanalyse/output_bench_nav_${legacy}.root"
+  if [[ -z "$real" ]]; then
+    echo "legacyBooleans=${legacy} : no timing found" >&2
+    return
+  fi
+  awk -v n="$EVENTS" -v t="$real" -v l="$legacy" \
+    'BEGIN { printf "legacyBooleans=%-5s  events=%d  real=%.2f s  -> %.0f events/s\n", l, n, t, n/t }'
+}
+
+run_one true
+run_one false
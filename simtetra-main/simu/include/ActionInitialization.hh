@@ -6,7 +6,9 @@
 #include "PrimaryGenerator.hh"
 #include "RunAction.hh"
 #include "EventAction.hh"
-#include "SteppingAction.hh"
+#include "StackingAction.hh"
+#include "ProfilingAction.hh"
+#include "RunMode.hh"
 
 class MyActionInitialization : public G4VUserActionInitialization
 {
@@ -19,6 +21,7 @@ public:
 	virtual void BuildForMaster() const;
 private:
 	G4String fMacroName = "137Cs.mac"; // nom du macro pour RunAction
+	RunMode  fRunMode   = RunMode::Full; // TETRA_RUN_MODE
 
 };
 
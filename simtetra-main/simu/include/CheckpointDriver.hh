@@ -0,0 +1,51 @@
+#ifndef CheckpointDriver_h
+#define CheckpointDriver_h
+
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+// ============================
+// Runs longs découpés en tranches reprenables (/tetra/checkpoint/..., master)
+//  - beamOn N : N évènements en tranches de 'interval' évènements, un /run/beamOn
+//    et un fichier <sortie>_part<k>.root par tranche (fermé, donc sûr, à la fin
+//    de chaque tranche)
+//  - après chaque tranche, le fichier d'état (stateFile) est réécrit
+//    atomiquement : total demandé, taille de tranche, tranches terminées, graine,
+//    fichier de la première tranche (sans le runID, qui repart de 0 après reprise)
+//  - resume <stateFile> : reprend à la première tranche non terminée, après avoir
+//    supprimé ses fichiers partiels ; refuse si le nom de sortie a changé (TAG, macro)
+//  - graines du master fixées par tranche (graine, k) : une tranche rejouée après
+//    reprise donne les mêmes évènements, sans sauvegarder l'état RNG des threads
+// Perte maximale après préemption : une tranche. Fusion : hadd sur les _part*.root.
+// ============================
+class MyCheckpointDriver
+{
+public:
+    MyCheckpointDriver();
+    ~MyCheckpointDriver();
+
+private:
+    struct State {
+        G4long totalEvents = 0;
+        G4long chunkEvents = 0;
+        G4long chunksDone  = 0;
+        G4long seed        = 0;
+        G4String output;               // fichier de la tranche 0
+    };
+
+    void BeamOn(G4int nEvents);
+    void Resume(G4String stateFile);
+    void RunChunks(State& state);
+    G4String ChunkFileName(G4long chunk) const;
+    void RemoveChunkFiles(const G4String& fileName) const;
+
+    G4bool ReadState(const G4String& fileName, State& state) const;
+    G4bool WriteState(const State& state) const;
+
+    G4GenericMessenger* fMessenger = nullptr;
+    G4int    fInterval  = 1000000;                 // évènements par tranche
+    G4int    fSeed      = 0;                       // 0 = tirée de l'horloge
+    G4String fStateFile = "tetra_checkpoint.txt";
+};
+
+#endif
@@ -1,54 +1,42 @@
 #pragma once
 
 #include "G4VSensitiveDetector.hh"
-#include "G4THitsCollection.hh"
-#include "G4VHit.hh"
-#include "G4Allocator.hh"
-#include "G4ThreeVector.hh"
 #include "G4Step.hh"
 #include "G4TouchableHistory.hh"
 #include "G4SystemOfUnits.hh"
 
-#include <vector>
+#include "ParisRouting.hh"
+
+#include <array>
 
 // ============================
-// Hit = 1 cristal (1 copyNo)
+// Hit = 1 cristal (1 index PARIS)
+// Slot fixe par thread : pas d'allocation par évènement
 // ============================
-class CrystalHit : public G4VHit {
+class CrystalHit {
 public:
-  CrystalHit() = default;
-  explicit CrystalHit(G4int copy) : fCopyNo(copy) {}
-
-  inline void* operator new(size_t);
-  inline void  operator delete(void*);
-
   void Add(G4double edep, G4double time);
+  void Reset() { fEdep = 0.0; fTFirst = -1.0; fTEwSum = 0.0; fTEw = -1.0; }
 
-  G4int    GetCopyNo() const { return fCopyNo; }
+  G4bool   IsEmpty()   const { return fTFirst < 0.0; }
   G4double GetEdep()   const { return fEdep; }     // MeV
   G4double GetTFirst() const { return fTFirst; }   // ns (ou -1 si aucun dépôt)
   G4double GetTEw()    const { return fTEw; }      // ns (ou -1 si aucun dépôt)
 
 private:
-  G4int    fCopyNo  = -1;
   G4double fEdep    = 0.0;   // MeV
   G4double fTFirst  = -1.0;  // ns
   G4double fTEwSum  = 0.0;   // MeV*ns
   G4double fTEw     = -1.0;  // ns
 };
 
-using CrystalHitsCollection = G4THitsCollection<CrystalHit>;
-
-extern G4ThreadLocal G4Allocator<CrystalHit>* CrystalHitAllocator;
-
 // ============================
 // Sensitive Detector
 // ============================
 class CrystalSD : public G4VSensitiveDetector {
 public:
-  CrystalSD(const G4String& name,
-            const G4String& hitsCollectionName,
-            G4int copyDepth = 0); // depth=0 -> copyNo du volume courant
+  // routes : table volume physique -> index PARIS (propriété de MyDetectorConstruction)
+  CrystalSD(const G4String& name, const ParisRoutingTable* routes);
 
   ~CrystalSD() override = default;
 
@@ -56,10 +44,20 @@ public:
   G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
   void EndOfEvent(G4HCofThisEvent* /*hce*/) override;
 
+  // Lecture directe par MyEventAction (même thread) : slot par index PARIS
+  // et liste des slots touchés dans l'évènement courant.
+  const CrystalHit& GetSlot(G4int parisIndex) const { return fSlots[parisIndex]; }
+  G4int GetNTouched() const { return fNTouched; }
+  G4int GetTouched(G4int i) const { return fTouched[i]; }
+
+  // Dépôt direct (utilisé aussi par ParisFastSimModel) : edep en MeV, time en ns
+  void AddDeposit(G4int parisIndex, G4double edep, G4double time);
+
 private:
-  CrystalHit* GetOrCreateHit(G4int copyNo);
+  std::array<CrystalHit, kNParis> fSlots;
+  std::array<G4int, kNParis> fTouched{};   // dirty-list (index PARIS)
+  G4int fNTouched = 0;
 
-  CrystalHitsCollection* fHitsCollection = nullptr;
-  G4int fHCID = -1;
-  G4int fCopyDepth = 0;
-};
\ No newline at end of file
+  const ParisRoutingTable* fRoutes = nullptr;
+  G4bool fWarnedUnrouted = false;
+};
@@ -31,6 +31,12 @@
 #include "G4LogicalVolumeStore.hh"
 #include <unordered_map>
 
+#include "ParisRouting.hh"
+#include "ParisFastSimModel.hh"
+#include "He3CellSD.hh"
+
+class G4Region;
+
 
 class MyDetectorConstruction : public G4VUserDetectorConstruction
 {
@@ -67,9 +73,50 @@ public :
     bool HasParisLabel(int copyNo) const {
         return ParisLabels.find(copyNo) != ParisLabels.end();
     }
+
+    // /detector/parisFastSim : lu par MyPhysicsList au début de /run/initialize
+    G4bool IsParisFastSim() const { return fParisFastSim; }
+
+    // Table de routage des cristaux PARIS (remplie dans Construct)
+    const ParisRoutingTable& GetParisRoutes() const { return fParisRoutes; }
+
+    // Centre de la face avant Ce de chaque PARIS (repère monde, rempli dans Construct)
+    const G4ThreeVector& GetParisFaceCentre(G4int parisIndex) const { return fParisFaceCentres[parisIndex]; }
+    // Axe du PARIS (normale entrante de la face Ce, repère monde)
+    const G4ThreeVector& GetParisAxis(G4int parisIndex) const { return fParisAxes[parisIndex]; }
     
 private:
+    void RegisterParisImprint(G4AssemblyVolume* assembly, const G4LogicalVolume* lvCe,
+                              const G4LogicalVolume* lvNaI, G4int parisIndex);
+    void ConfigureRegions();
+    void SetRegionDeex(G4String args);
+
     std::unordered_map<int, std::string> ParisLabels;  // Plus rapide pour les grandes collections
+    ParisRoutingTable fParisRoutes;                    // PV d'imprint Ce/NaI -> index PARIS
+    std::array<G4ThreeVector, kNParis> fParisFaceCentres;
+    std::array<G4ThreeVector, kNParis> fParisAxes;
+    He3CellTable fCells;                               // copy number cellule -> anneau/tube
+    G4bool fKillHe3Products = false;
+    G4bool fLegacyBooleans = false;    // châssis / coques en G4UnionSolid imbriqués (benchmark)
+
+    // Fast-sim PARIS (région PARISRegion = cristaux Ce + NaI)
+    G4Region* fParisRegion = nullptr;
+    G4bool   fParisFastSim = false;          // false : tracking complet
+    G4String fParisFastSimLibraryFile = "../paris_fastsim_library.txt";
+    G4double fParisFastSimMaxAngle = 10.*deg;  // acceptance angulaire sur la face Ce
+    ParisFastSimLibrary fParisFastSimLibrary;   // chargée par le master dans Construct
+
+    // Régions (ConfigureRegions) : coupure de production (0 = coupure par défaut à /run/initialize)
+    // et désexcitation atomique {fluo, auger, pixe} par région
+    struct RegionConfig {
+        G4String name;
+        std::vector<G4String> roots;          // logical volumes racines
+        G4double cut = 0.;
+        std::array<G4bool, 3> deex = {false, false, false};
+        G4bool deexFromGlobal = false;        // flags globaux /process/em/* (PARIS)
+    };
+    std::vector<RegionConfig> fRegions;
+    G4GenericMessenger* fRegionMessenger = nullptr;
     
     G4LogicalVolume *logicCellOne, *logicCellTwo, *logicCellThree, *logicCellFour;
     
@@ -2,40 +2,78 @@
 #define EventAction_h
 
 #include "G4UserEventAction.hh"
+#include "G4AnalysisManager.hh"
 #include "globals.hh"
 
+#include "ParisRouting.hh"
+#include "RunMode.hh"
+
+#include <array>
+#include <cstdint>
+
 class G4Event;
 class MyRunAction; // fwd decl
+class MyPrimaryGenerator;
+class CrystalSD;
+class He3CellSD;
+namespace ParisStream { class Writer; }
 
 class MyEventAction : public G4UserEventAction {
 public:
-  explicit MyEventAction(MyRunAction* runAction); // <-- AJOUT
+  MyEventAction(MyRunAction* runAction, const MyPrimaryGenerator* generator,
+                RunMode mode = RunMode::Full);
   ~MyEventAction() override = default;
 
   void BeginOfEventAction(const G4Event*) override;
   void EndOfEventAction  (const G4Event*) override;
-  
-  // Méthodes pour compter les hits par ring
-  void AddHitToRing(G4int ringNumber);
-  void ResetRingCounters();
+
+  // Appelé par MyRunAction::BeginOfRunAction (worker) : résout une fois
+  // les pointeurs utilisés à chaque évènement (SD, analysis manager, ids)
+  void BeginOfRun();
 
 private:
+  // Traitement spécialisé par mode (RunModePolicy), choisi une fois au constructeur
+  template <class Mode> void ProcessEvent(const G4Event* evt);
+  void (MyEventAction::*fProcessEvent)(const G4Event*) = nullptr;
+
+  // Accumulateur par PARIS (slot fixe, remis à zéro via le masque)
+  struct ParisAcc {
+    G4double eCe_keV      = 0.0;
+    G4double eNaI_keV     = 0.0;
+    G4double tFirstCe_ns  = -1.0; // -1 si aucun dépôt
+    G4double tFirstNaI_ns = -1.0;
+  };
+
   // pointeur vers le RunAction si tu en as besoin (ntuple ids, etc.)
   MyRunAction* fRunAction = nullptr;
+  // énergie vraie du primaire fournie directement par le générateur
+  const MyPrimaryGenerator* fGenerator = nullptr;
+
+  // Pointeurs du run (résolus dans BeginOfRun)
+  G4AnalysisManager* fAnalysisManager = nullptr;
+  G4int fRespNtupleId = -1;
+  G4bool   fSparse = false;            // copie de /tetra/output/sparse
+  G4double fSparseThreshold_keV = 0.0; // copie de /tetra/output/threshold
+  G4bool   fNtuples = true;            // copie de /tetra/output/ntuples
+
+  // Ids des histos de réponse (-1 si non réservés)
+  std::array<G4int, kNParis> fRespRawH2Id{};
+  std::array<G4int, kNParis> fRespSmearedH2Id{};
+  std::array<G4int, kNParis> fRespFineH2Id{};
+  std::array<G4int, kNParis> fGenH1Id{};
+  G4bool fSmearing = true;             // copie de /tetra/output/smearing
+  ParisStream::Writer* fStream = nullptr;  // /tetra/output/stream (nullptr si désactivé)
+  G4int fRunID = 0;
+
+  // SD cristaux du thread (slots lus directement, résolus une fois)
+  const CrystalSD* fCeSD  = nullptr;   // "CeCrystalSD"
+  const CrystalSD* fNaISD = nullptr;   // "NaICrystalSD"
+
+  // SD des cellules He3 (entrées + captures par anneau)
+  const He3CellSD* fHe3SD = nullptr;  // "He3CellSD"
 
-  // IDs des hits collections (résolus une fois)
-  G4int fHCID_CeEdep  = -1;   // "CeSD/eDep"
-  G4int fHCID_NaIEdep = -1;   // "NaISD/eDep"
-  G4int fHCID_CellIn  = -1;   // "CellSD/nNeutronEnter"
-  
-  // Compteurs de hits par ring pour l'événement en cours
-  G4int fHitsRing1 = 0;
-  G4int fHitsRing2 = 0;
-  G4int fHitsRing3 = 0;
-  G4int fHitsRing4 = 0;
-
-  // helper
-  G4double GetHitsMapSum(G4int hcID, const G4Event* evt) const;
+  std::array<ParisAcc, kNParis> fAcc{};
+  std::uint16_t fTouchedMask = 0;     // bit i = PARIS i touché dans l'évènement
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "G4VSensitiveDetector.hh"
+#include "G4Step.hh"
+#include "G4TouchableHistory.hh"
+
+#include <array>
+#include <vector>
+
+// ============================
+// Cellule He3 : anneau (1..4) et tube, précalculés au placement
+// ============================
+struct He3CellInfo {
+  G4int ring = 0;   // 0 = pas une cellule de gaz (ex: tube acier)
+  G4int tube = -1;
+};
+
+// Indexée par le copy number des placements de PlaceRingCells
+using He3CellTable = std::vector<He3CellInfo>;
+
+// ============================
+// Sensitive Detector des cellules He3
+//  - compte les traces entrant dans le gaz (ex-"CellSD/nThermalEnter")
+//  - score la réaction n + 3He -> p + t au pas d'interaction du neutron
+// ============================
+class He3CellSD : public G4VSensitiveDetector {
+public:
+  // cells : table copy number -> (anneau, tube) (propriété de MyDetectorConstruction)
+  He3CellSD(const G4String& name, const He3CellTable* cells, G4bool killProducts = false);
+
+  ~He3CellSD() override = default;
+
+  void Initialize(G4HCofThisEvent* hce) override;
+  G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
+
+  // Lecture par MyEventAction (même thread)
+  G4int GetNEnter() const { return fNEnter; }
+  G4int GetRingHits(G4int ring) const { return fRingHits[ring - 1]; } // ring 1..4
+  const std::vector<G4int>& GetCaptureTubes() const { return fCaptureTubes; }
+
+private:
+  const He3CellTable* fCells = nullptr;
+  G4bool fKillProducts = false;  // tuer p/t dès leur création
+
+  G4int fNEnter = 0;
+  std::array<G4int, 4> fRingHits{};
+  std::vector<G4int> fCaptureTubes;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "G4VFastSimulationModel.hh"
+#include "G4FastTrack.hh"
+#include "G4FastStep.hh"
+#include "globals.hh"
+
+#include "ParisRouting.hh"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+class CrystalSD;
+
+// ============================
+// Bibliothèque de réponse PARIS (issue de nos scans en simulation complète)
+// Fichier texte, une ligne par photon entré par la face avant du Ce le long de l'axe
+// (/tetra/gen/faceBeam, cf. myanalyse/BuildFastSimLibrary.C) :
+//   parisIdx crystal(0=Ce,1=NaI) Einc_keV eCe_keV eNaI_keV dtCe_ns dtNaI_ns
+// dt = temps du premier dépôt après l'entrée dans le cristal (-1 si pas de dépôt).
+// Les échantillons sont rangés par bin résolution (BuildParisEdges) en Einc.
+// Chargée une fois par le master, lue en lecture seule par les workers.
+// ============================
+struct ParisFastSimSample {
+  G4float eInc_keV  = 0.f;
+  G4float eCe_keV   = 0.f;
+  G4float eNaI_keV  = 0.f;
+  G4float dtCe_ns   = -1.f;
+  G4float dtNaI_ns  = -1.f;
+};
+
+class ParisFastSimLibrary {
+public:
+  G4bool Load(const G4String& fileName);
+  G4bool IsLoaded() const { return fNSamples > 0; }
+
+  // Échantillon tiré dans le bin contenant eInc (nullptr si bin vide : pas de couverture)
+  const ParisFastSimSample* Sample(G4int parisIndex, CrystalType crystal, G4double eInc) const;
+
+private:
+  struct Table {
+    std::vector<G4double> edges;                        // keV
+    std::vector<std::vector<ParisFastSimSample>> bins;
+  };
+  std::array<std::array<Table, 2>, kNParis> fTables;
+  std::size_t fNSamples = 0;
+};
+
+// ============================
+// Modèle rapide : photon entrant par la face avant d'un cristal Ce (région PARISRegion),
+// à moins de maxAngle de l'axe (population de la bibliothèque)
+//  -> dépôts Ce/NaI et temps tirés dans la bibliothèque, écrits directement
+//     dans les CrystalSD du thread (même format de sortie qu'en tracking complet)
+//  -> entrée latérale, par le NaI, hors acceptance ou hors couverture : tracking complet
+// ============================
+class ParisFastSimModel : public G4VFastSimulationModel {
+public:
+  ParisFastSimModel(const G4String& name, G4Region* envelope,
+                    const ParisFastSimLibrary* library, const ParisRoutingTable* routes,
+                    CrystalSD* sdCe, CrystalSD* sdNaI, G4double maxAngle);
+  ~ParisFastSimModel() override = default;
+
+  G4bool IsApplicable(const G4ParticleDefinition& particle) override;
+  G4bool ModelTrigger(const G4FastTrack& fastTrack) override;
+  void   DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep) override;
+
+  // Photons paramétrés depuis le dernier appel, tous threads (MyRunAction, master)
+  static G4long TakeNFired() { return fNFired.exchange(0); }
+
+private:
+  static inline std::atomic<G4long> fNFired{0};
+
+  const ParisFastSimLibrary* fLibrary = nullptr;
+  const ParisRoutingTable*   fRoutes  = nullptr;
+  CrystalSD* fSdCe  = nullptr;
+  CrystalSD* fSdNaI = nullptr;
+  G4double   fCosMaxAngle = 1.0;
+
+  // Choisis dans ModelTrigger, consommés dans DoIt (modèle par thread)
+  const ParisFastSimSample* fPending = nullptr;
+  G4int fPendingIndex = -1;
+};
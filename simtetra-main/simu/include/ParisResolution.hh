@@ -0,0 +1,55 @@
+#ifndef ParisResolution_h
+#define ParisResolution_h
+
+#include "globals.hh"
+#include "ParisRouting.hh"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+// ---------- Paramètres de résolution par PARIS ----------
+// FWHM/E = resA * E^resPower (E en keV)
+struct ParisResParams { G4double resA; G4double resPower; };
+
+// Indexé directement par l'index PARIS 0..8 (même table que MakeResponseForUnfolding.C)
+inline constexpr std::array<ParisResParams, kNParis> kParisRes = {{ // run du 05/08/2024
+  {1.12145,  -0.441244},  // 0 PARIS50
+  {1.80973,  -0.550685},  // 1 PARIS70
+  {1.94868,  -0.564616},  // 2 PARIS90
+  {2.11922,  -0.582147},  // 3 PARIS110
+  {0.794233, -0.377311},  // 4 PARIS130
+  {1.30727,  -0.477402},  // 5 PARIS235
+  {1.76345,  -0.542769},  // 6 PARIS262
+  {1.98579,  -0.559095},  // 7 PARIS278
+  {1.9886,   -0.574021}   // 8 PARIS305
+}};
+
+inline constexpr std::array<const char*, kNParis> kParisNames = {{
+  "PARIS50", "PARIS70", "PARIS90", "PARIS110", "PARIS130",
+  "PARIS235", "PARIS262", "PARIS278", "PARIS305"
+}};
+
+// Nombre de bins "résolution" jusqu'à ~15 MeV (cf. [OK] dans MakeResponseForUnfolding.C)
+inline constexpr std::array<G4int, kNParis> kParisNBins = {{
+  138, 199, 206, 218, 121, 156, 192, 194, 218
+}};
+
+// Même règle que buildEdges de MakeResponseForUnfolding.C :
+// edges[0]=Emin, edges[1]=Emin+11 keV, puis largeur = resA*E^resPower*E
+inline std::vector<G4double> BuildParisEdges(G4int parisIndex, G4double Emin_keV = 0.0)
+{
+  const ParisResParams& P = kParisRes[parisIndex];
+  const G4int nbins = kParisNBins[parisIndex];
+
+  std::vector<G4double> edges(nbins + 1);
+  edges[0] = Emin_keV;
+  edges[1] = Emin_keV + 11.0;
+  for (G4int i = 2; i < nbins + 1; ++i) {
+    const G4double prev = edges[i-1];
+    edges[i] = prev + P.resA * std::pow(prev, P.resPower) * prev;
+  }
+  return edges;
+}
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef ParisRouting_h
+#define ParisRouting_h
+
+#include "globals.hh"
+
+#include <unordered_map>
+
+class G4VPhysicalVolume;
+
+// Nombre de détecteurs PARIS : index dense 0..8 (ordre des thetas dans Construct)
+constexpr G4int kNParis = 9;
+
+enum class CrystalType : G4int { Ce = 0, NaI = 1 };
+
+// Une entrée de routage : volume physique d'imprint -> (PARIS, type de cristal)
+struct ParisRoute {
+  G4int       parisIndex = -1;
+  CrystalType crystal    = CrystalType::Ce;
+};
+
+// Construite une fois dans MyDetectorConstruction::Construct (master),
+// lue en lecture seule par les SD des threads workers.
+using ParisRoutingTable = std::unordered_map<const G4VPhysicalVolume*, ParisRoute>;
+
+#endif
@@ -0,0 +1,195 @@
+#pragma once
+
+// ============================
+// Flux binaire des dépôts PARIS (/tetra/output/stream) : alternative compacte aux
+// ntuples ParisEdep + resp + paris_time. Sans dépendance Geant4 / ROOT : ce même
+// en-tête sert à l'écriture (MyRunAction / MyEventAction) et à la lecture
+// (myanalyse/ReadParisStream.C).
+//
+// Fichier : en-tête de 4 kiB, puis blocs de 64 kiB alignés (mmap direct)
+//   bloc = BlockHeader (32 o) + 2047 enregistrements de 32 o
+//   eventID = firstEvent du bloc + somme des dEvent depuis le début du bloc
+//   un changement de run ou un écart > 65535 évènements ouvre un nouveau bloc
+// Un fichier par thread (<sortie>_t<N>.pstream), pas de verrou à l'écriture.
+// ============================
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ParisStream {
+
+inline constexpr char          kMagic[8]    = {'T','P','S','T','R','M','0','1'};
+inline constexpr std::uint32_t kVersion     = 1;
+inline constexpr std::size_t   kHeaderBytes = 4096;
+inline constexpr std::size_t   kBlockBytes  = 65536;
+
+struct FileHeader {
+  char          magic[8];
+  std::uint32_t version;
+  std::uint32_t headerBytes;
+  std::uint32_t blockBytes;
+  std::uint32_t recordBytes;
+  std::uint32_t recordsPerBlock;
+  std::uint32_t reserved;
+};
+
+// Un PARIS touché dans un évènement
+struct Record {
+  std::uint16_t dEvent;     // eventID - eventID de l'enregistrement précédent du bloc
+  std::uint8_t  det;        // index PARIS 0..8
+  std::uint8_t  flags;      // réservé
+  std::int32_t  trueBin;    // bin tiré par /tetra/gen (-1 sinon)
+  float eCe_keV;            // dépôt Ce brut (smearing / repli à la lecture)
+  float eNaI_keV;
+  float tCe_ns;             // premier dépôt, -1 si aucun
+  float tNaI_ns;
+  float eTrue_keV;
+  float weight;             // émission en cône (1 sinon)
+};
+
+struct BlockHeader {
+  std::uint64_t firstEvent;
+  std::uint32_t nRecords;
+  std::int32_t  runID;
+  std::uint8_t  reserved[16];
+};
+
+inline constexpr std::size_t kRecordsPerBlock = (kBlockBytes - sizeof(BlockHeader)) / sizeof(Record);
+
+struct Block {
+  BlockHeader header;
+  Record      records[kRecordsPerBlock];   // 32 + 2047*32 = 64 kiB exactement
+};
+
+static_assert(sizeof(Record) == 32, "Record : 32 octets");
+static_assert(sizeof(BlockHeader) == 32, "BlockHeader : 32 octets");
+static_assert(sizeof(Block) == kBlockBytes, "Block : taille fixe");
+static_assert(sizeof(FileHeader) <= kHeaderBytes, "FileHeader trop grand");
+
+// ---------- Écriture (un objet par thread) ----------
+class Writer {
+public:
+  Writer() = default;
+  Writer(const Writer&) = delete;
+  Writer& operator=(const Writer&) = delete;
+  ~Writer() { Close(); }
+
+  bool Open(const std::string& path) {
+    Close();
+    fFile = std::fopen(path.c_str(), "wb");
+    if (!fFile) return false;
+    unsigned char header[kHeaderBytes] = {};
+    FileHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.headerBytes = kHeaderBytes;
+    h.blockBytes = kBlockBytes;
+    h.recordBytes = sizeof(Record);
+    h.recordsPerBlock = kRecordsPerBlock;
+    std::memcpy(header, &h, sizeof(h));
+    std::fwrite(header, 1, kHeaderBytes, fFile);
+    fBlock.header.nRecords = 0;
+    return true;
+  }
+
+  bool IsOpen() const { return fFile != nullptr; }
+
+  void Add(std::int32_t runID, std::uint64_t eventID, const Record& rec) {
+    BlockHeader& h = fBlock.header;
+    if (h.nRecords > 0 &&
+        (h.nRecords == kRecordsPerBlock || runID != h.runID ||
+         eventID < fLastEvent || eventID - fLastEvent > 0xFFFF)) {
+      Flush();
+    }
+    if (h.nRecords == 0) {
+      h.firstEvent = eventID;
+      h.runID = runID;
+      fLastEvent = eventID;
+    }
+    Record& r = fBlock.records[h.nRecords++];
+    r = rec;
+    r.dEvent = static_cast<std::uint16_t>(eventID - fLastEvent);
+    fLastEvent = eventID;
+  }
+
+  void Close() {
+    if (!fFile) return;
+    Flush();
+    std::fclose(fFile);
+    fFile = nullptr;
+  }
+
+private:
+  void Flush() {
+    if (!fFile || fBlock.header.nRecords == 0) return;
+    std::fwrite(&fBlock, sizeof(Block), 1, fFile);
+    std::memset(&fBlock, 0, sizeof(Block));
+  }
+
+  std::FILE* fFile = nullptr;
+  Block fBlock{};
+  std::uint64_t fLastEvent = 0;
+};
+
+// ---------- Lecture : mmap, parcours sans désérialisation ----------
+class Reader {
+public:
+  explicit Reader(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st{};
+    if (::fstat(fd, &st) == 0 && (std::size_t)st.st_size >= kHeaderBytes) {
+      void* p = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED) {
+        fData = static_cast<const std::uint8_t*>(p);
+        fSize = st.st_size;
+        ::madvise(p, fSize, MADV_SEQUENTIAL);
+      }
+    }
+    ::close(fd);
+    if (fData && std::memcmp(fData, kMagic, sizeof(kMagic)) != 0) Unmap();
+  }
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+  ~Reader() { Unmap(); }
+
+  bool IsOpen() const { return fData != nullptr; }
+  std::size_t NBlocks() const { return fData ? (fSize - kHeaderBytes) / kBlockBytes : 0; }
+  const Block& GetBlock(std::size_t i) const {
+    return *reinterpret_cast<const Block*>(fData + kHeaderBytes + i*kBlockBytes);
+  }
+
+  // f(runID, eventID, const Record&) pour chaque enregistrement, dans l'ordre du fichier
+  template <class F>
+  void ForEach(F&& f) const {
+    for (std::size_t b = 0; b < NBlocks(); ++b) {
+      const Block& block = GetBlock(b);
+      std::uint64_t event = block.header.firstEvent;
+      for (std::uint32_t i = 0; i < block.header.nRecords; ++i) {
+        const Record& r = block.records[i];
+        event += r.dEvent;
+        f(block.header.runID, event, r);
+      }
+    }
+  }
+
+private:
+  void Unmap() {
+    if (fData) ::munmap(const_cast<std::uint8_t*>(fData), fSize);
+    fData = nullptr;
+    fSize = 0;
+  }
+
+  const std::uint8_t* fData = nullptr;
+  std::size_t fSize = 0;
+};
+
+} // namespace ParisStream
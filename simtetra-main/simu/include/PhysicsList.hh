@@ -2,6 +2,7 @@
 #define PhysicsList_h
 
 #include "G4VModularPhysicsList.hh"
+#include "G4VStateDependent.hh"
 
 #include "G4EmPenelopePhysics.hh"
 #include "G4HadronElasticPhysicsHP.hh"
@@ -14,14 +15,47 @@
 #include "GammaNuclearPhysics.hh"
 #include "globals.hh"
 
-class MyPhysicsList : public G4VModularPhysicsList
+class G4GenericMessenger;
+
+class MyPhysicsList : public G4VModularPhysicsList, public G4VStateDependent
 {
 public:
 	MyPhysicsList();
-	~MyPhysicsList() override = default;
+	~MyPhysicsList() override;
 
 public:
 	void ConstructParticle() override;
+	// Master : ajoute les modèles EM de PARISRegion (/tetra/physics/parisEmModel)
+	void ConstructProcess() override;
+	// Master : choisit entre relecture du cache de tables et construction
+	void SetCuts() override;
+
+	// Appelé par MyRunAction (master) une fois les tables construites :
+	// écrit le cache si la clé courante n'y était pas encore.
+	void StoreTableCache();
+
+	// Master, PreInit -> Init : enregistre les constructeurs du profil choisi
+	// (+ G4FastSimulationPhysics si /detector/parisFastSim true)
+	G4bool Notify(G4ApplicationState requestedState) override;
+
+private:
+	// Clé = version Geant4 + constructeurs + paramètres EM + coupures + matériaux
+	G4String TableCacheKey() const;
+	void SetEmModel(G4String model);
+	void SetProfile(G4String profile);
+	void BuildProfile();
+
+	G4GenericMessenger* fMessenger = nullptr;
+	G4String fCacheDir;        // /tetra/physics/cacheDir ou $TETRA_PHYS_CACHE ("" = désactivé)
+	G4String fCacheKeyDir;     // fCacheDir/<clé> du run courant
+	G4bool   fStoreCache = false;
+	G4String fParisEmModel = "none";   // modèles EM de PARISRegion ("none" = ceux du constructeur global)
+
+	// /tetra/physics/profile : constructeurs enregistrés une seule fois (BuildProfile)
+	G4String fProfile = "decay-source";
+	G4bool   fProfileBuilt = false;
+	G4VPhysicsConstructor* fNeutronHP = nullptr;   // créé dans le constructeur (/testhadr/phys/)
+	G4bool   fNeutronHPRegistered = false;
 };
 
 #endif
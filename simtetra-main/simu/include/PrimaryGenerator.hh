@@ -10,9 +10,16 @@
 #include "G4IonTable.hh"
 #include "G4ParticleDefinition.hh"
 #include "Randomize.hh"
+#include "G4ThreeVector.hh"
 #include "globals.hh"
 
+#include "ParisRouting.hh"
+
+#include <array>
+#include <vector>
+
 class G4GeneralParticleSource;
+class G4GenericMessenger;
 class G4Event;
 
 class MyPrimaryGenerator : public G4VUserPrimaryGeneratorAction
@@ -23,8 +30,62 @@ public:
 
   void GeneratePrimaries(G4Event*) override;
 
+  // Énergie du premier gamma primaire de l'évènement courant (0 si aucun)
+  G4double GetTrueEnergy() const { return fTrueEnergy; }
+  // Bin vrai tiré (modes discrete/uniform), -1 en mode gps
+  G4int GetTrueBin() const { return fTrueBin; }
+  // Poids de l'évènement : 1 en émission GPS, fraction d'angle solide en mode cône
+  G4double GetEventWeight() const { return fEventWeight; }
+
+  // Liste d'énergies en keV (energies_list_*.mac ou une valeur par ligne), vide si illisible
+  static std::vector<G4double> ReadEnergyList(const G4String& fileName);
+
 private:
+  // Scan en énergie dans un seul /run/beamOn :
+  //  gps      : énergie donnée par /gps/... (défaut)
+  //  discrete : centre d'un bin tiré au hasard (équiprobable)
+  //  uniform  : uniforme dans le bin tiré
+  enum class EnergyMode { GPS, Discrete, Uniform };
+
+  void SetEnergyMode(const G4String& mode);
+  void LoadEnergyList(const G4String& fileName);   // energies_list_*.mac ou bincenters_*.txt
+  void UseParisEdges(G4int parisIndex);            // bins résolution (ParisResolution.hh)
+  void SetBinsFromCenters();
+  void SetBinsFromEdges();
+  G4double SampleEnergy();
+
+  // Émission biaisée : cône autour de l'axe source -> face Ce d'un PARIS
+  //  off  : direction GPS (défaut)
+  //  0..8 : toujours le même PARIS
+  //  all  : les neuf PARIS à tour de rôle (eventID % 9)
+  void SetConeTarget(const G4String& target);
+  void EmitIntoCone(G4Event* anEvent);
+  void LoadParisGeometry();
+
+  // Faisceau pencil sur la face Ce d'un PARIS (bibliothèque fast-sim) :
+  // vertex 1 µm devant le centre de la face, direction = axe du PARIS
+  //  off  : position / direction GPS (défaut)
+  //  0..8 : PARIS visé (prioritaire sur coneTarget)
+  void SetFaceBeam(const G4String& target);
+  void EmitOnFace(G4Event* anEvent);
+
   G4GeneralParticleSource* fGPS = nullptr;
+  G4GenericMessenger* fMessenger = nullptr;
+
+  EnergyMode fEnergyMode = EnergyMode::GPS;
+  std::vector<G4double> fCenters; // keV
+  std::vector<G4double> fEdges;   // keV, fCenters.size()+1
+
+  G4double fTrueEnergy = 0.0;
+  G4int    fTrueBin    = -1;
+
+  G4int    fConeTarget    = -1;          // -1 : off ; kNParis : all
+  G4double fConeHalfAngle = 10.*deg;
+  G4bool   fFaceCentresSet = false;      // lus dans MyDetectorConstruction au 1er évènement
+  std::array<G4ThreeVector, kNParis> fFaceCentres;
+  std::array<G4ThreeVector, kNParis> fParisAxes;
+  G4int    fFaceBeam = -1;               // -1 : off
+  G4double fEventWeight = 1.0;
 };
 
 #endif
\ No newline at end of file
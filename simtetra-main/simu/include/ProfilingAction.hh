@@ -0,0 +1,85 @@
+#ifndef ProfilingAction_h
+#define ProfilingAction_h
+
+#include "G4UserSteppingAction.hh"
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4VProcess;
+
+// ============================
+// Profilage pas / traces / temps (TETRA_PROFILE=1, installé par MyActionInitialization)
+// Clé = (volume logique, particule, processus) :
+//  - pas : volume du point pré-pas, processus qui limite le pas
+//  - traces : comptées à leur premier pas, volume de naissance, processus créateur
+//  - temps : 1 pas sur N (/tetra/profile/sampling) chronométré depuis le pas précédent,
+//    multiplié par N (inclut la gestion de pile et de trace entre deux pas)
+// Table par thread sans verrou, fusionnée en fin de run (MyRunAction) puis affichée
+// par le master : par volume, par particule, par processus ; table complète en CSV.
+// Le master a sa propre instance (BuildForMaster, sans pas) : seule à déclarer
+// /tetra/profile/file, non diffusée aux workers.
+// ============================
+class MyProfilingAction : public G4UserSteppingAction
+{
+public:
+    MyProfilingAction();
+    ~MyProfilingAction() override;
+
+    void UserSteppingAction(const G4Step* step) override;
+
+    // Worker (ou séquentiel), fin de run : ajoute la table du thread à la table commune
+    void Flush();
+    // Master, après les workers : tables triées par temps, CSV si /tetra/profile/file
+    void Report(G4int runID) const;
+
+private:
+    struct Key {
+        const G4LogicalVolume*      volume   = nullptr;
+        const G4ParticleDefinition* particle = nullptr;
+        const G4VProcess*           process  = nullptr;
+        bool operator==(const Key& o) const {
+            return volume == o.volume && particle == o.particle && process == o.process;
+        }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const {
+            const auto a = reinterpret_cast<std::uintptr_t>(k.volume);
+            const auto b = reinterpret_cast<std::uintptr_t>(k.particle);
+            const auto c = reinterpret_cast<std::uintptr_t>(k.process);
+            return (a * 31u + b) * 31u + c;
+        }
+    };
+    struct Counts {
+        G4long   steps   = 0;
+        G4long   tracks  = 0;
+        G4double seconds = 0.0;   // estimation (échantillon x N)
+    };
+    using NamedKey = std::tuple<std::string, std::string, std::string>;
+
+    std::unordered_map<Key, Counts, KeyHash> fCounts;   // thread
+
+    // Échantillonnage du temps
+    G4GenericMessenger* fMessenger = nullptr;
+    G4int  fSampling    = 100;
+    G4long fStepCounter = 0;
+    G4bool fMarked      = false;
+    std::chrono::steady_clock::time_point fMark;
+
+    // Table commune (noms : les pointeurs sont propres à chaque thread)
+    static inline std::mutex fMergeMutex;
+    static inline std::map<NamedKey, Counts> fMerged;
+
+    G4String fCsvFile;   // /tetra/profile/file, master (vide = pas de CSV)
+};
+
+#endif
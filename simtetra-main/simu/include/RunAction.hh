@@ -4,10 +4,21 @@
 #include "G4UserRunAction.hh"
 #include "G4AnalysisManager.hh"
 #include "G4Run.hh"
+#include "G4Accumulable.hh"
+#include "G4GenericMessenger.hh"
+#include "G4SystemOfUnits.hh"
 #include "globals.hh"
+#include "ParisRouting.hh"
+#include "StackingAction.hh"
+#include "ParisStream.hh"
+#include <array>
 #include <sstream>
 #include <string>
 #include <atomic>
+#include <chrono>
+
+class MyEventAction;
+class MyProfilingAction;
 
 class MyRunAction : public G4UserRunAction
 {
@@ -21,6 +32,65 @@ public:
   inline G4int TruthRespNtupleId() const { return fTruthRespNtupleId; }
   inline G4int TruthAllNtupleId() const { return fTruthAllNtupleId; }
 
+  // Worker : l'EventAction résout ses pointeurs au début de chaque run
+  void SetEventAction(MyEventAction* ev) { fEventAction = ev; }
+  // Profilage optionnel (TETRA_PROFILE=1) : worker, table fusionnée en fin de run ;
+  // master, instance qui affiche la table (owned : détruite avec la run action)
+  void SetProfiler(MyProfilingAction* profiler, G4bool owned = false) {
+    fProfiler = profiler;
+    fOwnsProfiler = owned;
+  }
+
+  // Mode "sparse" : seuls les évènements/PARIS au-dessus du seuil sont écrits
+  G4bool   IsSparseOutput()  const { return fSparseOutput; }
+  G4double SparseThreshold() const { return fSparseThreshold; }
+
+  // Ntuples par évènement (#0, #3, #4, #5) : optionnels (debug) si les H2 suffisent
+  G4bool IsNtupleOutput() const { return fNtupleOutput; }
+
+  // Matrices de réponse par PARIS (X = Emeas, Y = Etrue, binning résolution)
+  // -1 si non réservées (/tetra/output/respHistos false, défaut ; hRespFine : autre PARIS
+  // que /tetra/output/fineDetector)
+  G4int RespH2Id(G4int parisIndex, G4bool smeared) const {
+    return smeared ? fRespSmearedH2Id[parisIndex] : fRespRawH2Id[parisIndex];
+  }
+  G4int GenH1Id(G4int parisIndex) const { return fGenH1Id[parisIndex]; }
+  G4int RespFineH2Id(G4int parisIndex) const { return fRespFineH2Id[parisIndex]; }
+
+  // false : pas de tirage gaussien par évènement (repli analytique hors simulation)
+  G4bool IsSmearing() const { return fSmearing; }
+
+  // Comptage par évènement (worker), fusionné en fin de run dans RunMeta
+  void CountEvent(G4bool eventWritten, G4int parisRowsWritten, G4int parisRowsSuppressed) {
+    fNEventsGenerated += 1;
+    if (eventWritten) fNEventsWritten += 1;
+    fNParisRowsWritten    += parisRowsWritten;
+    fNParisRowsSuppressed += parisRowsSuppressed;
+    ++fThreadEvents;
+    ++fEventsDoneAll;
+    if (std::chrono::steady_clock::now() >= fNextProgress) PrintProgress();
+  }
+
+  // Flux binaire du thread (/tetra/output/stream), nullptr si désactivé ;
+  // ouvert avec le fichier ROOT, IsOpen() faux sur le master MT
+  ParisStream::Writer* StreamWriter() { return fStreamOutput ? &fStream : nullptr; }
+
+  // Scan en énergie (/tetra/scan, MyScanDriver sur le master) : le fichier reste
+  // ouvert entre les runs du scan ; l'énergie du run est écrite dans RunMeta
+  static void SetScanState(G4bool keepFileOpen, G4double energy) {
+    fKeepFileOpen = keepFileOpen;
+    fScanEnergy   = energy;
+  }
+
+  // Tranches reprenables (/tetra/checkpoint, master entre deux runs) :
+  // suffixe ajouté au nom du fichier de sortie ("_part<k>", vide sinon)
+  static void SetOutputSuffix(const G4String& suffix) { fOutputSuffix = suffix; }
+  // Nom du fichier de sortie ROOT (TAG ou macro + runID, runID omis en tranches)
+  G4String OutputFileName(G4int runID, const G4String& suffix) const;
+
+  // Traces tuées par MyStackingAction (worker), catégorie = StackKill
+  void CountKilledTrack(G4int category) { fNKilled[category] += 1; }
+
 private:
 // Utilisé pour nommer le fichier ROOT de sortie
   G4String fMacroName;
@@ -30,7 +100,55 @@ private:
   // Gestion d'ouverture unique du fichier de sortie sur plusieurs /run/beamOn
   // Utiliser atomic<bool> pour sécurité minimale entre threads (lecture/écriture simple)
   std::atomic<bool> fFileOpened{false};
+  G4bool fNtupleMerging = true;   // false : un fichier de ntuples par worker (TETRA_NTUPLE_MERGING=0)
   G4String fOutFileName;
+  static inline std::atomic<bool>   fKeepFileOpen{false};
+  static inline std::atomic<double> fScanEnergy{0.0};   // 0 hors scan
+  static inline G4String fOutputSuffix;                  // lu au début de chaque run
+
+  // Progression / rapport (MyRunReport) : compteurs du thread et du run entier
+  void PrintProgress();
+  std::chrono::steady_clock::time_point fRunStart;
+  std::chrono::steady_clock::time_point fNextProgress = std::chrono::steady_clock::time_point::max();
+  G4long fThreadEvents = 0;
+  static inline std::atomic<G4long> fEventsDoneAll{0};
+  static inline std::atomic<G4long> fEventsToProcess{0};
+
+  MyEventAction* fEventAction = nullptr; // nullptr sur le master
+  MyProfilingAction* fProfiler = nullptr; // nullptr sans TETRA_PROFILE
+  G4bool fOwnsProfiler = false;           // instance du master (pas une user action)
+
+  // /tetra/output/...
+  G4GenericMessenger* fMessenger = nullptr;
+  G4bool   fSparseOutput    = false;
+  G4double fSparseThreshold = 0.0;      // énergie (Ce + NaI) minimale d'un PARIS
+  G4bool   fNtupleOutput    = true;
+  G4bool   fRespHistos      = false;
+
+  G4bool   fSmearing        = true;
+  G4double fFineBinWidth    = 0.0;      // 0 = pas de hRespFine_*
+  G4int    fFineDetector    = -1;       // PARIS de hRespFine_* (-1 = aucun)
+  G4bool   fStreamOutput    = false;
+  G4int    fCompressionLevel = -1;     // -1 = défaut Geant4 (zlib 1)
+  G4int    fBasketSize       = 0;      // 0 = défaut Geant4
+  G4int    fBasketEntries    = 0;      // 0 = défaut Geant4
+  ParisStream::Writer fStream;
+  static constexpr G4double kFineEmax_keV = 15000.0;
+
+  // Réservation paresseuse (après les commandes UI, identique master/workers)
+  void BookResponseHistos();
+  std::array<G4int, kNParis> fRespRawH2Id;
+  std::array<G4int, kNParis> fRespSmearedH2Id;
+  std::array<G4int, kNParis> fRespFineH2Id;
+  std::array<G4int, kNParis> fGenH1Id;
+
+  // Métadonnées du run (efficacités exactes même en mode sparse)
+  G4int fRunMetaNtupleId = -1;
+  G4Accumulable<G4long> fNEventsGenerated     {0};
+  G4Accumulable<G4long> fNEventsWritten       {0};
+  G4Accumulable<G4long> fNParisRowsWritten    {0};
+  G4Accumulable<G4long> fNParisRowsSuppressed {0};
+  std::array<G4Accumulable<G4long>, kNStackKill> fNKilled {};
 };
 
 #endif
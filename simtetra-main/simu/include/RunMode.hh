@@ -0,0 +1,55 @@
+#ifndef RunMode_h
+#define RunMode_h
+
+#include "globals.hh"
+
+// ============================
+// Modes de run (TETRA_RUN_MODE, lu par MyActionInitialization)
+//   full               : tout (défaut, comportement historique)
+//   gamma-response     : PARIS -> hGen / matrices de réponse / resp / flux binaire
+//   source-spectra     : PARIS -> ParisEdep, paris_time, Events (totaux Ce/NaI)
+//   neutron-efficiency : He3 seul -> Events (entrées gaz, captures par anneau)
+// Chaque mode est une politique à la compilation : MyEventAction instancie un
+// traitement d'évènement par mode, le travail inutile n'y est pas compilé.
+// ============================
+enum class RunMode { Full, GammaResponse, SourceSpectra, NeutronEfficiency };
+
+namespace RunModePolicy {
+  //                          PARIS  réponse spectres  He3   Events
+  template <bool P, bool R, bool S, bool N, bool E>
+  struct Policy {
+    static constexpr bool kParis    = P;  // accumulation Ce / NaI par PARIS
+    static constexpr bool kResponse = R;  // hGen, H2 de réponse, ntuple resp, flux binaire
+    static constexpr bool kSpectra  = S;  // ntuples ParisEdep et paris_time
+    static constexpr bool kNeutron  = N;  // entrées He3 et captures par anneau
+    static constexpr bool kEvents   = E;  // ntuple Events
+  };
+
+  using Full              = Policy<true,  true,  true,  true,  true>;
+  using GammaResponse     = Policy<true,  true,  false, false, false>;
+  using SourceSpectra     = Policy<true,  false, true,  false, true>;
+  using NeutronEfficiency = Policy<false, false, false, true,  true>;
+}
+
+inline const char* RunModeName(RunMode mode)
+{
+  switch (mode) {
+    case RunMode::GammaResponse:     return "gamma-response";
+    case RunMode::SourceSpectra:     return "source-spectra";
+    case RunMode::NeutronEfficiency: return "neutron-efficiency";
+    default:                         return "full";
+  }
+}
+
+// Nom inconnu : ok = false et mode full
+inline RunMode ParseRunMode(const G4String& name, G4bool& ok)
+{
+  ok = true;
+  if (name == "gamma-response")     return RunMode::GammaResponse;
+  if (name == "source-spectra")     return RunMode::SourceSpectra;
+  if (name == "neutron-efficiency") return RunMode::NeutronEfficiency;
+  ok = name.empty() || name == "full";
+  return RunMode::Full;
+}
+
+#endif
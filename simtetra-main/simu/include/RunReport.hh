@@ -0,0 +1,74 @@
+#ifndef RunReport_h
+#define RunReport_h
+
+#include "G4VStateDependent.hh"
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+// ============================
+// Rapport de run lisible par les scripts batch (/tetra/report/..., master)
+//  - progression périodique par thread pendant /run/beamOn (MyRunAction::CountEvent)
+//  - JSON à la sortie de simTetra : temps d'initialisation, par run durée, évènements,
+//    évènements/s par thread, octets écrits (ROOT + _t*.root + .pstream), RSS max
+// Fichier : /tetra/report/file, sinon $TETRA_RUN_REPORT, sinon report_<TAG>.json
+// (simTetra_report.json sans TAG) ; vide = pas de rapport.
+// ============================
+class MyRunReport : public G4VStateDependent
+{
+public:
+    MyRunReport();
+    ~MyRunReport() override;
+
+    static MyRunReport* Instance() { return fInstance; }   // nullptr hors simTetra
+
+    // Durée de l'initialisation (PreInit/Idle -> Init -> Idle)
+    G4bool Notify(G4ApplicationState requestedState) override;
+
+    // Intervalle de progression (s) lu par les workers, 0 = pas d'affichage
+    static G4double ProgressInterval() { return fProgressInterval; }
+
+    // Fin de run d'un thread qui traite des évènements (worker, ou master en séquentiel)
+    void AddThreadRun(G4int threadID, G4long nEvents, G4double seconds);
+    // Fin de run master, après les workers : regroupe les threads du run
+    void AddRun(G4int runID, G4long nEvents, G4double seconds, const G4String& outFile);
+
+    // Écrit le JSON (fin de simTetra.cc)
+    void Write(G4double wall_s, G4double cpu_s) const;
+
+private:
+    struct ThreadRun {
+        G4int    threadID = 0;
+        G4long   nEvents  = 0;
+        G4double seconds  = 0.0;
+    };
+    struct RunEntry {
+        G4int    runID   = 0;
+        G4long   nEvents = 0;
+        G4double seconds = 0.0;
+        G4long   bytes   = 0;
+        std::vector<ThreadRun> threads;
+    };
+
+    void SetProgressInterval(G4double seconds) { fProgressInterval = seconds; }
+    static G4long OutputBytes(const G4String& outFile);
+
+    static inline MyRunReport* fInstance = nullptr;
+    static inline std::atomic<double> fProgressInterval{30.0};
+
+    G4GenericMessenger* fMessenger = nullptr;
+    G4String fFileName;
+
+    std::chrono::steady_clock::time_point fInitStart;
+    G4double fInitSeconds = 0.0;
+
+    mutable std::mutex fMutex;
+    std::vector<ThreadRun> fPendingThreads;   // run en cours
+    std::vector<RunEntry>  fRuns;
+};
+
+#endif
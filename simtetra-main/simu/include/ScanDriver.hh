@@ -0,0 +1,34 @@
+#ifndef ScanDriver_h
+#define ScanDriver_h
+
+#include "G4GenericMessenger.hh"
+#include "globals.hh"
+
+#include <vector>
+
+// ============================
+// Scan en énergie dans un seul processus (/tetra/scan/..., master)
+//  - un /run/beamOn par énergie, géométrie et physique initialisées une fois
+//  - un seul fichier ROOT pour tout le scan (MyRunAction::SetScanState),
+//    RunMeta : une ligne par énergie (runID, scanEnergy_keV, compteurs),
+//    ntuples par évènement : colonne runID pour joindre avec RunMeta
+//  - progression et temps restant estimé après chaque énergie
+// Remplace run_energy_list.sh / run_single_energy_batch.sh (un processus par énergie).
+// ============================
+class MyScanDriver
+{
+public:
+    MyScanDriver();
+    ~MyScanDriver();
+
+private:
+    void LoadEnergyList(G4String fileName);
+    void Start();
+
+    G4GenericMessenger* fMessenger = nullptr;
+    std::vector<G4double> fEnergies;          // keV
+    G4int    fEventsPerEnergy = 10000;
+    G4String fEnergyCommand   = "/gps/ene/mono";  // suivi de "<E> keV"
+};
+
+#endif
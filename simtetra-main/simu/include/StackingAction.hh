@@ -0,0 +1,44 @@
+#ifndef StackingAction_h
+#define StackingAction_h
+
+#include "G4UserStackingAction.hh"
+#include "G4GenericMessenger.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+class MyRunAction;
+
+// Catégories de traces tuées (compteurs fusionnés dans RunMeta)
+enum class StackKill { Fragment = 0, Neutron, Neutrino, Electron };
+inline constexpr G4int kNStackKill = 4;
+
+// ============================
+// Élagage des secondaires à la mise en pile (/tetra/stack/...)
+//  - fragments de fission / noyaux lourds (A > 4)
+//  - neutrons (runs Cf-252 où seuls les gammas PARIS comptent)
+//  - neutrinos
+//  - électrons sous electronCut nés hors d'un volume sensible
+// Les primaires ne sont jamais tuées. Tout est désactivé par défaut.
+// ============================
+class MyStackingAction : public G4UserStackingAction
+{
+public:
+    explicit MyStackingAction(MyRunAction* runAction);
+    ~MyStackingAction() override;
+
+    G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track) override;
+
+private:
+    // gammaResponse | cf252Paris | none
+    void SetPreset(G4String preset);
+
+    MyRunAction* fRunAction = nullptr;
+    G4GenericMessenger* fMessenger = nullptr;
+
+    G4bool   fKillFragments = false;
+    G4bool   fKillNeutrons  = false;
+    G4bool   fKillNeutrinos = false;
+    G4double fElectronCut   = 0.;       // 0 = électrons jamais tués
+};
+
+#endif
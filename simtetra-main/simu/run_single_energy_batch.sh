@@ -13,6 +13,7 @@
 #   QUIET=1            suppress Geant4 banner
 #   NTHREADS=32        Geant4 MT threads per run (default 32)
 #   BASE_SEED=12345    base seed for the whole batch (default: current epoch seconds)
+#   TETRA_PHYS_CACHE=dir  physics-table cache shared by all runs (default: ./physics_cache, "" to disable)
 # Output:
 #   ROOT files moved to: ../../myanalyse/<PARIS_ID>/output_<PARIS_ID>_E<energy>keV.root
 #   Simple logs: logs/<PARIS_ID>_E<energy>.log (only if QUIET not set)
@@ -30,6 +31,9 @@ mkdir -p "$LOGDIR"
 # ---- NEW: base seed for the whole batch (override with BASE_SEED=... in env) ----
 BASE_SEED=${BASE_SEED:-$(date +%s)}
 
+# ---- Physics-table cache: the first run writes it, the others reload it ----
+export TETRA_PHYS_CACHE=${TETRA_PHYS_CACHE-$BUILD_DIR/physics_cache}
+
 ENERGIES=()
 # Detect alias-style macro line like: /control/alias Elist {5.5 13.44 ...}
 if grep -qE '^[[:space:]]*/control/alias[[:space:]]+[A-Za-z_][A-Za-z0-9_]*[[:space:]]*\{.*\}' "$ENERGY_FILE"; then
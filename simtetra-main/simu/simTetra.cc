@@ -1,17 +1,25 @@
 #include <iostream>
 
 #include "G4RunManagerFactory.hh"
+#ifdef G4MULTITHREADED
+#include "G4TaskRunManager.hh"
+#endif
 #include "G4UIExecutive.hh"
 #include "G4VisExecutive.hh"
 #include "G4UImanager.hh"
 #include "G4SteppingVerbose.hh"
 #include "Randomize.hh"
 #include <chrono>
+#include <cstdlib>
 #include <ctime>
+#include <string>
 
 #include "DetectorConstruction.hh"
 #include "PhysicsList.hh"
 #include "ActionInitialization.hh"
+#include "ScanDriver.hh"
+#include "CheckpointDriver.hh"
+#include "RunReport.hh"
 
 #include "G4ParticleHPManager.hh"
 
@@ -21,12 +29,39 @@
 
 int main(int argc, char** argv)
 {
-  // --- Run manager (choisit tout seul Serial/MT selon la build)
-  auto* runManager = G4RunManagerFactory::CreateRunManager();
+  // --- Run manager : TETRA_RUN_MANAGER = default | serial | mt | tasking
+  //     (default : Serial/MT/Tasking selon la build, ou G4RUN_MANAGER_TYPE)
+  //     Tasking : les évènements sont distribués par paquets de taille
+  //     TETRA_GRAINSIZE (nombre de tâches par run, défaut = nb de threads) et
+  //     /run/eventModulo ; des paquets petits évitent qu'un thread garde
+  //     plusieurs évènements Cf-252 longs pendant que les autres attendent.
+  G4RunManagerType rmType = G4RunManagerType::Default;
+  if (const char* env = std::getenv("TETRA_RUN_MANAGER"); env && *env) {
+    const std::string type = env;
+    if      (type == "serial")  rmType = G4RunManagerType::Serial;
+    else if (type == "mt")      rmType = G4RunManagerType::MT;
+    else if (type == "tasking") rmType = G4RunManagerType::Tasking;
+    else if (type != "default") G4cerr << "TETRA_RUN_MANAGER inconnu : " << type << " (default utilisé)" << G4endl;
+  }
+  auto* runManager = G4RunManagerFactory::CreateRunManager(rmType);
   #ifdef G4MULTITHREADED
-     runManager->SetNumberOfThreads(G4Threading::G4GetNumberOfCores());
+     // /run/numberOfThreads dans les macros reste prioritaire
+     G4int nThreads = G4Threading::G4GetNumberOfCores();
+     if (const char* env = std::getenv("TETRA_NTHREADS"); env && std::atoi(env) > 0) nThreads = std::atoi(env);
+     runManager->SetNumberOfThreads(nThreads);
+
+     if (auto* taskRM = dynamic_cast<G4TaskRunManager*>(runManager)) {
+       G4cout << ">>> Run manager : Tasking" << G4endl;
+       if (const char* env = std::getenv("TETRA_GRAINSIZE"); env && std::atoi(env) > 0) {
+         taskRM->SetGrainsize(std::atoi(env));
+         G4cout << ">>> Grain size : " << std::atoi(env) << " tâches par run" << G4endl;
+       }
+     }
   #endif
 
+  // Progression + rapport JSON (/tetra/report/...), avant l'initialisation chronométrée
+  auto* runReport = new MyRunReport();
+
   // RNG + verbosité unités
   G4Random::setTheEngine(new CLHEP::RanecuEngine);
   G4SteppingVerbose::UseBestUnit(4);
@@ -38,6 +73,11 @@ int main(int argc, char** argv)
   G4String macroName = (argc > 1 ? G4String(argv[1]) : G4String("vis.mac"));
   runManager->SetUserInitialization(new MyActionInitialization(macroName));
 
+  // /tetra/scan/... : boucle en énergie dans ce processus (master)
+  auto* scanDriver = new MyScanDriver();
+  // /tetra/checkpoint/... : runs longs en tranches reprenables
+  auto* checkpointDriver = new MyCheckpointDriver();
+
   // Réglages HP (ok ici, avant /run/initialize)
   auto* hp = G4ParticleHPManager::GetInstance();
   hp->SetSkipMissingIsotopes(true);
@@ -79,6 +119,7 @@ int main(int argc, char** argv)
         << "Wall time : " << wall_s << " s\n"
         << "CPU time  : " << cpu_s  << " s\n"
         << "==========================\n" << G4endl;
+  runReport->Write(wall_s, cpu_s);
   // ---------- SHUTDOWN PROPRE ----------
   // Si tu fermes l’analyse dans les Run/Action via G4AutoDelete, ne fais rien ici.
   // Si, au contraire, tu ouvres/écris/fermes l’analyse dans main, fais-le AVANT de détruire le runManager :
@@ -89,6 +130,9 @@ int main(int argc, char** argv)
   //   // soit delete ana; soit : G4AutoDelete::Register(ana); (et ne pas le delete ici)
   // }
 
+  delete checkpointDriver;
+  delete runReport;
+  delete scanDriver;  // 0) messengers /tetra/scan et /tetra/checkpoint avant l'UI
   delete ui;          // 1) ferme l’UI d’abord
   delete visManager;  // 2) puis la visu
   delete runManager;  // 3) et enfin le run manager (dernier)
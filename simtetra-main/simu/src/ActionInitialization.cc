@@ -1,17 +1,39 @@
 #include "ActionInitialization.hh"
 
+#include <cstdlib>
+#include <string>
+
 MyActionInitialization::MyActionInitialization(const G4String& macroFileName)
 : G4VUserActionInitialization(),
   fMacroName(macroFileName)
-{}
+{
+	// Mode de run : lu avant toute construction d'action (Build() des workers
+	// peut précéder la lecture des macros), donc par l'environnement
+	if (const char* env = std::getenv("TETRA_RUN_MODE"); env && *env) {
+		G4bool ok = true;
+		fRunMode = ParseRunMode(env, ok);
+		if (!ok) G4cerr << "TETRA_RUN_MODE inconnu : " << env << " (full utilisé)" << G4endl;
+	}
+	G4cout << ">>> Mode de run : " << RunModeName(fRunMode) << G4endl;
+}
 MyActionInitialization::~MyActionInitialization()
 {}
 
+// TETRA_PROFILE=1 : profilage pas / traces / temps par volume, particule, processus
+static G4bool ProfilingEnabled()
+{
+	const char* env = std::getenv("TETRA_PROFILE");
+	return env && std::string(env) == "1";
+}
+
 
 void MyActionInitialization::BuildForMaster() const
 {
 	MyRunAction *runAction = new MyRunAction(fMacroName);
 	SetUserAction(runAction);	
+
+	// Instance du master : fusion des tables et /tetra/profile/file
+	if (ProfilingEnabled()) runAction->SetProfiler(new MyProfilingAction(), true);
 }
 
 void MyActionInitialization::Build() const
@@ -22,9 +44,17 @@ void MyActionInitialization::Build() const
     MyRunAction *runAction = new MyRunAction(fMacroName);
     SetUserAction(runAction);
     
-    MyEventAction *eventAction = new MyEventAction(runAction);
+    MyEventAction *eventAction = new MyEventAction(runAction, generator, fRunMode);
     SetUserAction(eventAction);
-    
-    MySteppingAction *steppingAction = new MySteppingAction(eventAction);
-    SetUserAction(steppingAction);
+    runAction->SetEventAction(eventAction);
+
+    // Élagage des secondaires (/tetra/stack/...), inactif par défaut
+    SetUserAction(new MyStackingAction(runAction));
+
+    // Pas de stepping action en production : la capture n+3He est scorée par He3CellSD.
+    if (ProfilingEnabled()) {
+        auto* profiler = new MyProfilingAction();
+        SetUserAction(profiler);
+        runAction->SetProfiler(profiler);
+    }
 }
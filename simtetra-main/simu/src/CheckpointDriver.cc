@@ -0,0 +1,181 @@
+#include "CheckpointDriver.hh"
+#include "RunAction.hh"
+
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+MyCheckpointDriver::MyCheckpointDriver()
+{
+    fMessenger = new G4GenericMessenger(this, "/tetra/checkpoint/", "Runs longs en tranches reprenables");
+    fMessenger->DeclareProperty("interval", fInterval,
+                                "Évènements par tranche (un fichier _part<k>.root par tranche)")
+              .SetRange("interval>0");
+    fMessenger->DeclareProperty("seed", fSeed,
+                                "Graine des tranches (0 = horloge), enregistrée dans le fichier d'état");
+    fMessenger->DeclareProperty("stateFile", fStateFile,
+                                "Fichier d'état réécrit après chaque tranche");
+    fMessenger->DeclareMethod("beamOn", &MyCheckpointDriver::BeamOn,
+                              "Lance N évènements en tranches (après /run/initialize)");
+    fMessenger->DeclareMethod("resume", &MyCheckpointDriver::Resume,
+                              "Reprend le run décrit par ce fichier d'état, jusqu'au total demandé");
+}
+
+MyCheckpointDriver::~MyCheckpointDriver() { delete fMessenger; }
+
+void MyCheckpointDriver::BeamOn(G4int nEvents)
+{
+    if (nEvents <= 0) return;
+    State state;
+    state.totalEvents = nEvents;
+    state.chunkEvents = fInterval;
+    state.seed        = (fSeed > 0) ? fSeed : static_cast<G4long>(std::time(nullptr) % 900000000) + 1;
+    state.output      = ChunkFileName(0);
+    if (!WriteState(state)) return;   // pas de run sans reprise possible
+    RunChunks(state);
+}
+
+void MyCheckpointDriver::Resume(G4String stateFile)
+{
+    State state;
+    if (!ReadState(stateFile, state)) {
+        G4Exception("MyCheckpointDriver::Resume","BadCheckpoint", JustWarning,
+                    ("Fichier d'état illisible : " + stateFile).c_str());
+        return;
+    }
+    // Même sortie qu'au lancement : sinon hadd *_part*.root mélangerait deux séries
+    if (const G4String output = ChunkFileName(0); output != state.output) {
+        G4Exception("MyCheckpointDriver::Resume","CheckpointOutputChanged", JustWarning,
+                    ("Sortie " + output + " différente de celle du fichier d'état ("
+                     + state.output + ") : vérifier TAG et la macro").c_str());
+        return;
+    }
+    fStateFile = stateFile;
+    // Tranche interrompue : ses fichiers (éventuellement zombies) sont refaits de zéro
+    RemoveChunkFiles(ChunkFileName(state.chunksDone));
+    G4cout << ">>> [checkpoint] reprise : " << state.chunksDone * state.chunkEvents << " / "
+           << state.totalEvents << " évènements déjà faits (" << stateFile << ")" << G4endl;
+    RunChunks(state);
+}
+
+void MyCheckpointDriver::RunChunks(State& state)
+{
+    auto* runManager = G4RunManager::GetRunManager();
+    const G4long nChunks = (state.totalEvents + state.chunkEvents - 1) / state.chunkEvents;
+    const auto t0 = std::chrono::steady_clock::now();
+    const G4long firstChunk = state.chunksDone;
+
+    for (G4long k = state.chunksDone; k < nChunks; ++k) {
+        const G4long nEvents = std::min(state.chunkEvents, state.totalEvents - k*state.chunkEvents);
+
+        // Même graine pour une même tranche : reprise reproductible
+        long seeds[3] = { static_cast<long>(state.seed), static_cast<long>(k + 1), 0 };
+        G4Random::setTheSeeds(seeds);
+        MyRunAction::SetOutputSuffix("_part" + std::to_string(k));
+        runManager->BeamOn(static_cast<G4int>(nEvents));
+
+        const G4Run* run = runManager->GetCurrentRun();
+        if (!run || run->GetNumberOfEvent() < nEvents) {
+            G4Exception("MyCheckpointDriver::RunChunks","ChunkIncomplete", JustWarning,
+                        "Tranche interrompue : elle sera rejouée par /tetra/checkpoint/resume");
+            break;
+        }
+
+        // Fichier de la tranche fermé : elle ne sera plus rejouée
+        state.chunksDone = k + 1;
+        WriteState(state);
+
+        const G4double elapsed = std::chrono::duration<G4double>(std::chrono::steady_clock::now() - t0).count();
+        const G4double eta = elapsed / (k + 1 - firstChunk) * (nChunks - k - 1);
+        G4cout << ">>> [checkpoint] tranche " << k + 1 << "/" << nChunks << " (" << nEvents
+               << " evts), état écrit ; restant ~" << eta << " s" << G4endl;
+    }
+
+    MyRunAction::SetOutputSuffix("");
+    if (state.chunksDone < nChunks) return;
+    G4cout << ">>> [checkpoint] run complet : " << state.totalEvents << " évènements en "
+           << nChunks << " fichiers _part*.root (fusion : hadd)" << G4endl;
+}
+
+// Fichier de sortie de la tranche k, nommé par le MyRunAction du master
+G4String MyCheckpointDriver::ChunkFileName(G4long chunk) const
+{
+    const auto* runAction = dynamic_cast<const MyRunAction*>(
+        G4RunManager::GetRunManager()->GetUserRunAction());
+    return runAction ? runAction->OutputFileName(0, "_part" + std::to_string(chunk)) : G4String();
+}
+
+// <sortie>.root et .pstream, plus les _t<N>.root / _t<N>.pstream des workers
+void MyCheckpointDriver::RemoveChunkFiles(const G4String& fileName) const
+{
+    namespace fs = std::filesystem;
+    if (fileName.empty()) return;
+    const fs::path file(std::string(fileName));
+    const std::string stem = file.stem().string();
+    const fs::path dir = file.has_parent_path() ? file.parent_path() : fs::path(".");
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        const std::string name = entry.path().filename().string();
+        const std::string ext  = entry.path().extension().string();
+        if (ext != ".root" && ext != ".pstream") continue;
+        const std::string s = entry.path().stem().string();
+        if (s != stem && s.rfind(stem + "_t", 0) != 0) continue;
+        if (fs::remove(entry.path(), ec)) {
+            G4cout << ">>> [checkpoint] fichier partiel supprimé : " << name << G4endl;
+        }
+    }
+}
+
+// Format texte "clé valeur", une par ligne
+G4bool MyCheckpointDriver::ReadState(const G4String& fileName, State& state) const
+{
+    std::ifstream in(fileName);
+    if (!in) return false;
+    std::map<std::string, G4long> values;
+    std::string key;
+    G4long value = 0;
+    for (std::string line; std::getline(in, line);) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream is(line);
+        if (!(is >> key)) continue;
+        if (key == "output") { is >> std::ws; std::getline(is, state.output); continue; }
+        if (is >> value) values[key] = value;
+    }
+    state.totalEvents = values["totalEvents"];
+    state.chunkEvents = values["chunkEvents"];
+    state.chunksDone  = values["chunksDone"];
+    state.seed        = values["seed"];
+    return state.totalEvents > 0 && state.chunkEvents > 0 && state.seed > 0 && !state.output.empty();
+}
+
+// Écriture dans un temporaire puis rename : un arrêt pendant l'écriture
+// laisse l'état précédent intact
+G4bool MyCheckpointDriver::WriteState(const State& state) const
+{
+    const std::string tmp = fStateFile + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        out << "# simTetra checkpoint (/tetra/checkpoint/resume " << fStateFile << ")\n"
+            << "totalEvents " << state.totalEvents << '\n'
+            << "chunkEvents " << state.chunkEvents << '\n'
+            << "chunksDone "  << state.chunksDone  << '\n'
+            << "seed "        << state.seed        << '\n'
+            << "output "      << state.output      << '\n';
+        if (!out.flush()) {
+            G4Exception("MyCheckpointDriver::WriteState","CheckpointWriteFailed", JustWarning,
+                        ("Impossible d'écrire " + tmp).c_str());
+            return false;
+        }
+    }
+    return std::rename(tmp.c_str(), fStateFile.c_str()) == 0;
+}
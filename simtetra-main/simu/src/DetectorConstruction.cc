@@ -1,5 +1,13 @@
 #include "DetectorConstruction.hh"
 #include "CrystalSD.hh"
+#include "He3CellSD.hh"
+#include "ParisFastSimModel.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4EmParameters.hh"
+#include "G4UIcommand.hh"
 #include "G4NistManager.hh"
 #include "G4GenericMessenger.hh"
 #include "G4SystemOfUnits.hh"
@@ -23,6 +31,8 @@
 #include "G4PSTrackCounter.hh"
 #include "G4SDParticleWithEnergyFilter.hh"
 
+#include <sstream>
+
 static void PlaceRingCells(
     G4double radius,
     G4double startPhi,
@@ -33,6 +43,8 @@ static void PlaceRingCells(
     G4LogicalVolume* logic_polycase2,
     G4ThreeVector shell_pos,
     G4ThreeVector shell2_pos,
+    G4int ring,
+    He3CellTable& cells,
     G4int& copyIndex)
 {
     G4double dphi = 360.*deg / nSectors;
@@ -82,6 +94,10 @@ static void PlaceRingCells(
         //         << G4endl;
         // }
 
+        // Table cellule : copy number -> (anneau, tube) pour He3CellSD
+        if ((G4int)cells.size() < copyIndex + 2) cells.resize(copyIndex + 2);
+        cells[copyIndex] = {ring, copyIndex / 2};
+
         new G4PVPlacement(0, localPos, logicCell, "physCell", logicMod, false, copyIndex++, false);
         new G4PVPlacement(0, localPos, logicCyl,  "physCyl",  logicMod, false, copyIndex++, false);
     }
@@ -91,10 +107,121 @@ MyDetectorConstruction::MyDetectorConstruction()
 {
     fMessenger = new G4GenericMessenger(this, "/detector/", "Detector Construction");
     fMessenger->DeclareProperty("Pressure", Pressure, "Pressure in gas");
+    fMessenger->DeclareProperty("killHe3Products", fKillHe3Products,
+                                "Tuer p/t de la capture n+3He dès leur création (avant /run/initialize)");
+    fMessenger->DeclareProperty("legacyBooleans", fLegacyBooleans,
+                                "Châssis NORCAN et coques en booléens imbriqués (ancienne géométrie, pour comparaison)");
+    fMessenger->DeclareProperty("parisFastSim", fParisFastSim,
+                                "Paramétrisation rapide des photons dans les cristaux PARIS (avant /run/initialize)");
+    fMessenger->DeclareProperty("parisFastSimLibrary", fParisFastSimLibraryFile,
+                                "Bibliothèque de réponse PARIS (BuildFastSimLibrary.C)");
+    fMessenger->DeclarePropertyWithUnit("parisFastSimMaxAngle", "deg", fParisFastSimMaxAngle,
+                                        "Angle max. à l'axe des photons paramétrés (entrée par la face Ce)");
     Pressure = 7*6.24151e+08; // MeV/mm3 (non utilisé ici mais conservé)
+
+    // Régions : seuls les cristaux PARIS gardent la désexcitation atomique demandée
+    // par /process/em/fluo|auger|pixe ; ailleurs (coques, châssis, supports, chambre)
+    // les électrons Auger / PIXE ne peuvent pas atteindre un cristal.
+    fRegions = {
+        {"PARISRegion",    {"SCIONIXPWLVCe", "SCParisPWLV.1"}, 0., {false, false, false}, true},
+        {"TetraModerator", {"logic_shell", "logic_shell2"}},
+        {"Structure",      {"logicChassis", "lv_barre_1", "lv_barre_2", "lv_barre_3", "lv_barre_4",
+                            "lv_barre_5", "lv_barre_6", "lv_barre_7", "lv_barre_8", "lv_barre_9",
+                            "lv_barre_10", "logicArc", "logicSupportABS_WithArc",
+                            "logicChariot", "logicBerceau"}},
+        {"IonChamber",     {"logicIC"}}
+    };
+
+    fRegionMessenger = new G4GenericMessenger(this, "/detector/region/", "Régions : coupures et désexcitation");
+    fRegionMessenger->DeclarePropertyWithUnit("parisCut", "mm", fRegions[0].cut,
+                                              "Coupure de production des cristaux PARIS (0 = défaut)");
+    fRegionMessenger->DeclarePropertyWithUnit("moderatorCut", "mm", fRegions[1].cut,
+                                              "Coupure de production du modérateur TETRA (0 = défaut)");
+    fRegionMessenger->DeclarePropertyWithUnit("structureCut", "mm", fRegions[2].cut,
+                                              "Coupure de production châssis / supports (0 = défaut)");
+    fRegionMessenger->DeclarePropertyWithUnit("ionChamberCut", "mm", fRegions[3].cut,
+                                              "Coupure de production de la chambre d'ionisation (0 = défaut)");
+    fRegionMessenger->DeclareMethod("deex", &MyDetectorConstruction::SetRegionDeex,
+                                    "Désexcitation par région : <région> <fluo> <auger> <pixe> (avant /run/initialize)");
 }
 
-MyDetectorConstruction::~MyDetectorConstruction() {}
+MyDetectorConstruction::~MyDetectorConstruction()
+{
+    delete fRegionMessenger;
+}
+
+void MyDetectorConstruction::SetRegionDeex(G4String args)
+{
+    std::istringstream is(args);
+    G4String name, fluo, auger, pixe;
+    if (!(is >> name >> fluo >> auger >> pixe)) {
+        G4Exception("MyDetectorConstruction::SetRegionDeex","BadRegionDeex", JustWarning,
+                    "Usage : /detector/region/deex <région> <fluo> <auger> <pixe>");
+        return;
+    }
+    for (auto& region : fRegions) {
+        if (region.name != name) continue;
+        region.deex = {G4UIcommand::ConvertToBool(fluo), G4UIcommand::ConvertToBool(auger),
+                       G4UIcommand::ConvertToBool(pixe)};
+        region.deexFromGlobal = false;
+        return;
+    }
+    G4Exception("MyDetectorConstruction::SetRegionDeex","UnknownRegion", JustWarning,
+                ("Région inconnue : " + name).c_str());
+}
+
+// Appelé en fin de Construct (master) : tous les logical volumes existent.
+// Chaque région reçoit ses propres G4ProductionCuts : G4VAtomDeexcitation associe
+// les flags d'une région aux couples par pointeur de coupures, une région sans
+// coupures propres partagerait donc ceux du World.
+void MyDetectorConstruction::ConfigureRegions()
+{
+    auto* lvStore  = G4LogicalVolumeStore::GetInstance();
+    auto* defCuts  = G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts();
+    auto* em       = G4EmParameters::Instance();
+
+    for (const auto& config : fRegions) {
+        auto* region = G4RegionStore::GetInstance()->FindOrCreateRegion(config.name);
+        for (const auto& lvName : config.roots) {
+            if (auto* lv = lvStore->GetVolume(lvName, false)) region->AddRootLogicalVolume(lv);
+        }
+
+        auto* cuts = region->GetProductionCuts();
+        if (!cuts || cuts == defCuts) {
+            cuts = new G4ProductionCuts(*defCuts);
+            region->SetProductionCuts(cuts);
+        }
+        if (config.cut > 0.) cuts->SetProductionCut(config.cut);
+
+        const std::array<G4bool, 3> deex = config.deexFromGlobal
+            ? std::array<G4bool, 3>{em->Fluo(), em->Auger(), em->Pixe()} : config.deex;
+        em->SetDeexActiveRegion(config.name, deex[0], deex[1], deex[2]);
+
+        G4cout << ">>> Région " << config.name << " : " << region->GetNumberOfRootVolumes()
+               << " volume(s) racine, coupure " << cuts->GetProductionCut(0)/mm << " mm"
+               << ", fluo/auger/pixe = " << deex[0] << "/" << deex[1] << "/" << deex[2] << G4endl;
+    }
+    // Le reste du monde : pas de désexcitation
+    em->SetDeexActiveRegion("World", false, false, false);
+}
+
+// Les volumes physiques créés par le dernier MakeImprint sont les derniers
+// du store de l'assembly (un par triplet) : on les route vers l'index PARIS.
+void MyDetectorConstruction::RegisterParisImprint(G4AssemblyVolume* assembly,
+                                                  const G4LogicalVolume* lvCe,
+                                                  const G4LogicalVolume* lvNaI,
+                                                  G4int parisIndex)
+{
+    auto itPV = assembly->GetVolumesIterator();
+    const std::size_t nPV  = assembly->TotalImprintedVolumes();
+    const std::size_t nNew = assembly->TotalTriplets();
+    for (std::size_t i = nPV - nNew; i < nPV; ++i) {
+        const G4VPhysicalVolume* pv = *(itPV + i);
+        const G4LogicalVolume* lv = pv->GetLogicalVolume();
+        if      (lv == lvCe)  fParisRoutes[pv] = {parisIndex, CrystalType::Ce};
+        else if (lv == lvNaI) fParisRoutes[pv] = {parisIndex, CrystalType::NaI};
+    }
+}
 
 G4VPhysicalVolume *MyDetectorConstruction::Construct()
 {
@@ -238,31 +365,59 @@ G4VPhysicalVolume *MyDetectorConstruction::Construct()
     // auto solid_polycase2_init  = new G4SubtractionSolid("solid_polycase2_init", solid_polycase2_init1, box_addon_polycase, nullptr, G4ThreeVector(+50./3./2.*mm, ((183+16.875))*mm, 0));
 
     auto solid_shell_init1 = new G4UnionSolid("solid_shell_init1", solid_half_shell, box_addon_shell, nullptr, G4ThreeVector(0*mm, 258*mm, 0));
-    auto solid_shell_init  = new G4SubtractionSolid("solid_shell_init", solid_shell_init1, box_addon_shell, nullptr, G4ThreeVector(0*mm, -258*mm, 0));
 
     auto solid_polycase_init1 = new G4UnionSolid("solid_polycase_init1", solid_half_polycase, box_addon_polycase, nullptr, G4ThreeVector(0*mm, ((183+16.875))*mm, 0));
-    auto solid_polycase_init  = new G4SubtractionSolid("solid_polycase_init", solid_polycase_init1, box_addon_polycase, nullptr, G4ThreeVector(0*mm, -(183+16.875)*mm, 0));
 
     auto solid_shell2_init1 = new G4UnionSolid("solid_shell2_init1", solid_half_shell2, box_addon_shell, nullptr, G4ThreeVector(0*mm, -258*mm, 0));
-    auto solid_shell2_init  = new G4SubtractionSolid("solid_shell2_init", solid_shell2_init1, box_addon_shell, nullptr, G4ThreeVector(0*mm, 258*mm, 0));
 
     auto solid_polycase2_init1 = new G4UnionSolid("solid_polycase2_init1", solid_half_polycase2, box_addon_polycase, nullptr, G4ThreeVector(0*mm, -(183+16.875)*mm, 0));
-    auto solid_polycase2_init  = new G4SubtractionSolid("solid_polycase2_init", solid_polycase2_init1, box_addon_polycase, nullptr, G4ThreeVector(0*mm, ((183+16.875))*mm, 0));
+
+    auto solid_hole = new G4Tubs("solid_pipe", 0.*mm, 67.5*mm, 620.*mm, 0.*deg, 360.0*deg); //520 mm → 620 mm pour traverser les deux coques
+    auto solidLightGuide = new G4Box("solidLightGuide", 2.25*cm, 25.*cm, 5.*cm);
+    G4ThreeVector yTrans(0., -67.5*mm, 0.);
+
+    G4VSolid *solid_shell, *solid_polycase, *solid_shell2, *solid_polycase2;
+    if (fLegacyBooleans) {
+        // Ancienne pile : 4 soustractions imbriquées par coque
+        auto solid_shell_init  = new G4SubtractionSolid("solid_shell_init", solid_shell_init1, box_addon_shell, nullptr, G4ThreeVector(0*mm, -258*mm, 0));
+        auto solid_polycase_init  = new G4SubtractionSolid("solid_polycase_init", solid_polycase_init1, box_addon_polycase, nullptr, G4ThreeVector(0*mm, -(183+16.875)*mm, 0));
+        auto solid_shell2_init  = new G4SubtractionSolid("solid_shell2_init", solid_shell2_init1, box_addon_shell, nullptr, G4ThreeVector(0*mm, 258*mm, 0));
+        auto solid_polycase2_init  = new G4SubtractionSolid("solid_polycase2_init", solid_polycase2_init1, box_addon_polycase, nullptr, G4ThreeVector(0*mm, ((183+16.875))*mm, 0));
 
         auto solid_shell_rabot   = new G4SubtractionSolid("solid_shell_rabot",    solid_shell_init,    box_cutoff, nullptr, G4ThreeVector(0*mm, 0*mm, 0));
         auto solid_shell2_rabot  = new G4SubtractionSolid("solid_shell2_rabot",   solid_shell2_init,   box_cutoff, nullptr, G4ThreeVector(0*mm, 0*mm, 0));
         auto solid_polycase_rabot= new G4SubtractionSolid("solid_polycase_rabot", solid_polycase_init, box_cutoff, nullptr, G4ThreeVector(0*mm, 0*mm, 0));
         auto solid_polycase2_rabot= new G4SubtractionSolid("solid_polycase2_rabot", solid_polycase2_init, box_cutoff, nullptr, G4ThreeVector(0*mm, 0*mm, 0));
 
-    auto solid_hole = new G4Tubs("solid_pipe", 0.*mm, 67.5*mm, 620.*mm, 0.*deg, 360.0*deg); //520 mm → 620 mm pour traverser les deux coques
-    auto solidLightGuide = new G4Box("solidLightGuide", 2.25*cm, 25.*cm, 5.*cm);
-    G4ThreeVector yTrans(0., -67.5*mm, 0.);
-    auto solid_pipe = new G4UnionSolid("solid_pipe", solid_hole, solidLightGuide, nullptr, yTrans);
+        auto solid_pipe = new G4UnionSolid("solid_pipe", solid_hole, solidLightGuide, nullptr, yTrans);
 
-    auto solid_shell    = new G4SubtractionSolid("solid_shell",    solid_shell_rabot,    solid_pipe);
-    auto solid_polycase = new G4SubtractionSolid("solid_polycase", solid_polycase_rabot, solid_pipe);
-    auto solid_shell2   = new G4SubtractionSolid("solid_shell2",   solid_shell2_rabot,   solid_hole);
-    auto solid_polycase2= new G4SubtractionSolid("solid_polycase2",solid_polycase2_rabot,solid_hole);
+        solid_shell    = new G4SubtractionSolid("solid_shell",    solid_shell_rabot,    solid_pipe);
+        solid_polycase = new G4SubtractionSolid("solid_polycase", solid_polycase_rabot, solid_pipe);
+        solid_shell2   = new G4SubtractionSolid("solid_shell2",   solid_shell2_rabot,   solid_hole);
+        solid_polycase2= new G4SubtractionSolid("solid_polycase2",solid_polycase2_rabot,solid_hole);
+    } else {
+        // (A ∪ B) − C − D − E = (A ∪ B) − (C ∪ D ∪ E) : une seule soustraction
+        // par coque, les outils de découpe regroupés dans un G4MultiUnion voxelisé
+        auto makeCutter = [&](const G4String& name, G4VSolid* addon, const G4ThreeVector& addonPos,
+                              G4bool withLightGuide) {
+            auto cutter = new G4MultiUnion(name);
+            cutter->AddNode(*addon,      G4Transform3D(G4RotationMatrix(), addonPos));
+            cutter->AddNode(*box_cutoff, G4Transform3D(G4RotationMatrix(), G4ThreeVector()));
+            cutter->AddNode(*solid_hole, G4Transform3D(G4RotationMatrix(), G4ThreeVector()));
+            if (withLightGuide) cutter->AddNode(*solidLightGuide, G4Transform3D(G4RotationMatrix(), yTrans));
+            cutter->Voxelize();
+            return cutter;
+        };
+
+        solid_shell     = new G4SubtractionSolid("solid_shell",     solid_shell_init1,
+                              makeCutter("cut_shell",     box_addon_shell,    G4ThreeVector(0*mm, -258*mm, 0), true));
+        solid_polycase  = new G4SubtractionSolid("solid_polycase",  solid_polycase_init1,
+                              makeCutter("cut_polycase",  box_addon_polycase, G4ThreeVector(0*mm, -(183+16.875)*mm, 0), true));
+        solid_shell2    = new G4SubtractionSolid("solid_shell2",    solid_shell2_init1,
+                              makeCutter("cut_shell2",    box_addon_shell,    G4ThreeVector(0*mm, 258*mm, 0), false));
+        solid_polycase2 = new G4SubtractionSolid("solid_polycase2", solid_polycase2_init1,
+                              makeCutter("cut_polycase2", box_addon_polycase, G4ThreeVector(0*mm, (183+16.875)*mm, 0), false));
+    }
 
 
 
@@ -302,20 +457,21 @@ G4VPhysicalVolume *MyDetectorConstruction::Construct()
 
     //PlaceRingCells(..., logicCellOne, logicCyl, logic_polycase, logic_polycase2,
         //       shell_pos, shell2_pos, copyIndex); j'avais origi, origin avant à la place des shell_pos
-    PlaceRingCells(2.*c,         -30.*deg, 6, logicCellOne,   logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
-    PlaceRingCells(std::sqrt(3.)*c, 0.*deg, 6, logicCellOne,   logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
-    PlaceRingCells(3.*c,         -30.*deg, 6, logicCellTwo,   logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
-    PlaceRingCells(std::sqrt(7.)*c,  10.893*deg, 6, logicCellTwo, logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
-    PlaceRingCells(std::sqrt(7.)*c, -10.893*deg, 6, logicCellTwo, logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
-    PlaceRingCells(4.*c,         -30.*deg, 6, logicCellThree, logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
-    PlaceRingCells(2.*std::sqrt(3.)*c, 0.*deg, 6, logicCellThree, logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
-    PlaceRingCells(std::sqrt(13.)*c,  16.102*deg, 6, logicCellThree, logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
-    PlaceRingCells(std::sqrt(13.)*c, -16.102*deg, 6, logicCellThree, logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
-    PlaceRingCells(5.*c,         -30.*deg, 6, logicCellFour,  logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
-    PlaceRingCells(std::sqrt(19.)*c,  6.587*deg, 6, logicCellFour,  logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
-    PlaceRingCells(std::sqrt(21.)*c, 19.107*deg, 6, logicCellFour,  logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
-    PlaceRingCells(std::sqrt(21.)*c,-19.107*deg, 6, logicCellFour,  logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
-    PlaceRingCells(std::sqrt(19.)*c, -6.587*deg, 6, logicCellFour,  logicCyl, logic_polycase, logic_polycase2, origin, origin, copyIndex);
+    fCells.clear();
+    PlaceRingCells(2.*c,         -30.*deg, 6, logicCellOne,   logicCyl, logic_polycase, logic_polycase2, origin, origin, 1, fCells, copyIndex);
+    PlaceRingCells(std::sqrt(3.)*c, 0.*deg, 6, logicCellOne,   logicCyl, logic_polycase, logic_polycase2, origin, origin, 1, fCells, copyIndex);
+    PlaceRingCells(3.*c,         -30.*deg, 6, logicCellTwo,   logicCyl, logic_polycase, logic_polycase2, origin, origin, 2, fCells, copyIndex);
+    PlaceRingCells(std::sqrt(7.)*c,  10.893*deg, 6, logicCellTwo, logicCyl, logic_polycase, logic_polycase2, origin, origin, 2, fCells, copyIndex);
+    PlaceRingCells(std::sqrt(7.)*c, -10.893*deg, 6, logicCellTwo, logicCyl, logic_polycase, logic_polycase2, origin, origin, 2, fCells, copyIndex);
+    PlaceRingCells(4.*c,         -30.*deg, 6, logicCellThree, logicCyl, logic_polycase, logic_polycase2, origin, origin, 3, fCells, copyIndex);
+    PlaceRingCells(2.*std::sqrt(3.)*c, 0.*deg, 6, logicCellThree, logicCyl, logic_polycase, logic_polycase2, origin, origin, 3, fCells, copyIndex);
+    PlaceRingCells(std::sqrt(13.)*c,  16.102*deg, 6, logicCellThree, logicCyl, logic_polycase, logic_polycase2, origin, origin, 3, fCells, copyIndex);
+    PlaceRingCells(std::sqrt(13.)*c, -16.102*deg, 6, logicCellThree, logicCyl, logic_polycase, logic_polycase2, origin, origin, 3, fCells, copyIndex);
+    PlaceRingCells(5.*c,         -30.*deg, 6, logicCellFour,  logicCyl, logic_polycase, logic_polycase2, origin, origin, 4, fCells, copyIndex);
+    PlaceRingCells(std::sqrt(19.)*c,  6.587*deg, 6, logicCellFour,  logicCyl, logic_polycase, logic_polycase2, origin, origin, 4, fCells, copyIndex);
+    PlaceRingCells(std::sqrt(21.)*c, 19.107*deg, 6, logicCellFour,  logicCyl, logic_polycase, logic_polycase2, origin, origin, 4, fCells, copyIndex);
+    PlaceRingCells(std::sqrt(21.)*c,-19.107*deg, 6, logicCellFour,  logicCyl, logic_polycase, logic_polycase2, origin, origin, 4, fCells, copyIndex);
+    PlaceRingCells(std::sqrt(19.)*c, -6.587*deg, 6, logicCellFour,  logicCyl, logic_polycase, logic_polycase2, origin, origin, 4, fCells, copyIndex);
 
     
     // Placements
@@ -355,21 +511,43 @@ G4VPhysicalVolume *MyDetectorConstruction::Construct()
         G4ThreeVector ytransheight2back = G4ThreeVector((750.*2.-80.)*mm, -335.*mm, -235.*mm); 
         G4ThreeVector ytransheight2front = G4ThreeVector((750.*2.-80.)*mm, -335.*mm,235.*mm); 
 
-        G4UnionSolid* norcan12 = new G4UnionSolid("norcan12",  norcandepth, norcanlength, nullptr, ztransback);
-        G4UnionSolid* norcan123 = new G4UnionSolid("norcan123", norcan12, norcanlength, nullptr, ztransfront);
-        G4UnionSolid* norcan1234 = new G4UnionSolid("norcan1234", norcan123, norcandepth, nullptr, ytransright);
-        G4UnionSolid* norcan12345 = new G4UnionSolid("norcan12345", norcan1234, norcanheight, nullptr, ytransheight1back);
-        G4UnionSolid* norcan123456 = new G4UnionSolid("norcan123456", norcan12345, norcanheight, nullptr, ytransheight1front);
-        G4UnionSolid* norcan1234567 = new G4UnionSolid("norcan1234567", norcan123456, norcanheight, nullptr, ytransheight2back);
-        G4UnionSolid* norcan12345678 = new G4UnionSolid("norcan12345678", norcan1234567, norcanheight, nullptr, ytransheight2front);
-        G4UnionSolid* norcanrenfo_1 = new G4UnionSolid("norcanrenfo_1", norcan12345678, norcanlengthrenfo, nullptr, trans_renfo_bas_long);
-        G4UnionSolid* norcanrenfo_2 = new G4UnionSolid("norcanrenfo_2", norcanrenfo_1, norcanlengthrenfo, nullptr, trans_renfo_bas_long_droit);
-        G4UnionSolid* norcanrenfo_3 = new G4UnionSolid("norcanrenfo_3", norcanrenfo_2, norcandepthrenfo, nullptr, trans_renfo_bas);
-        G4UnionSolid* norcanrenfo_4 = new G4UnionSolid("norcanrenfo_4", norcanrenfo_3, norcandepthrenfo,nullptr, trans_renfo_bas_droit);
+        G4VSolid* solidChassis = nullptr;
+        if (fLegacyBooleans) {
+            // Ancienne chaîne de G4UnionSolid imbriqués (arbre binaire parcouru à chaque appel)
+            G4UnionSolid* norcan12 = new G4UnionSolid("norcan12",  norcandepth, norcanlength, nullptr, ztransback);
+            G4UnionSolid* norcan123 = new G4UnionSolid("norcan123", norcan12, norcanlength, nullptr, ztransfront);
+            G4UnionSolid* norcan1234 = new G4UnionSolid("norcan1234", norcan123, norcandepth, nullptr, ytransright);
+            G4UnionSolid* norcan12345 = new G4UnionSolid("norcan12345", norcan1234, norcanheight, nullptr, ytransheight1back);
+            G4UnionSolid* norcan123456 = new G4UnionSolid("norcan123456", norcan12345, norcanheight, nullptr, ytransheight1front);
+            G4UnionSolid* norcan1234567 = new G4UnionSolid("norcan1234567", norcan123456, norcanheight, nullptr, ytransheight2back);
+            G4UnionSolid* norcan12345678 = new G4UnionSolid("norcan12345678", norcan1234567, norcanheight, nullptr, ytransheight2front);
+            G4UnionSolid* norcanrenfo_1 = new G4UnionSolid("norcanrenfo_1", norcan12345678, norcanlengthrenfo, nullptr, trans_renfo_bas_long);
+            G4UnionSolid* norcanrenfo_2 = new G4UnionSolid("norcanrenfo_2", norcanrenfo_1, norcanlengthrenfo, nullptr, trans_renfo_bas_long_droit);
+            G4UnionSolid* norcanrenfo_3 = new G4UnionSolid("norcanrenfo_3", norcanrenfo_2, norcandepthrenfo, nullptr, trans_renfo_bas);
+            G4UnionSolid* norcanrenfo_4 = new G4UnionSolid("norcanrenfo_4", norcanrenfo_3, norcandepthrenfo,nullptr, trans_renfo_bas_droit);
+            solidChassis = norcan12345678;
+        } else {
+            // Mêmes 8 barres (les renforts norcanrenfo_* n'étaient pas placés) en un
+            // G4MultiUnion voxelisé : Inside/DistanceToIn ne testent que les barres proches
+            auto norcanTETRA = new G4MultiUnion("norcanTETRA");
+            auto addBar = [&](G4VSolid* bar, const G4ThreeVector& pos) {
+                norcanTETRA->AddNode(*bar, G4Transform3D(G4RotationMatrix(), pos));
+            };
+            addBar(norcandepth,  G4ThreeVector());
+            addBar(norcanlength, ztransback);
+            addBar(norcanlength, ztransfront);
+            addBar(norcandepth,  ytransright);
+            addBar(norcanheight, ytransheight1back);
+            addBar(norcanheight, ytransheight1front);
+            addBar(norcanheight, ytransheight2back);
+            addBar(norcanheight, ytransheight2front);
+            norcanTETRA->Voxelize();
+            solidChassis = norcanTETRA;
+        }
 
         //G4UnionSolid* norcanTETRA = ;
         //G4LogicalVolume* logicChassis = new G4LogicalVolume(norcan1234, aluminium, "logicChassis");
-        G4LogicalVolume* logicChassis = new G4LogicalVolume(norcan12345678, aluminium, "logicChassis");
+        G4LogicalVolume* logicChassis = new G4LogicalVolume(solidChassis, aluminium, "logicChassis");
         G4PVPlacement* physChassis = new G4PVPlacement(0, G4ThreeVector(-710.*mm, -660.*mm, 0.*mm), logicChassis, "physChassis", logicWorld, false, 0, checkOverlaps);
         // //---------------------------------------------------
         // // Support châssis NORCAN en aluminium de la chambre d'ionisation + PARIS
@@ -612,6 +790,14 @@ G4VPhysicalVolume *MyDetectorConstruction::Construct()
         G4Exception("MyDetectorConstruction::Construct","PARIS-MissingLV",FatalException,
                     "Logical(s) PARIS introuvable(s) dans le GDML.");
     }
+    // Région des cristaux : enveloppe du modèle rapide (ConstructSDandField)
+    fParisRegion = G4RegionStore::GetInstance()->FindOrCreateRegion("PARISRegion");
+    fParisRegion->AddRootLogicalVolume(lvCe);
+    fParisRegion->AddRootLogicalVolume(lvNaI);
+    if (fParisFastSim && !fParisFastSimLibrary.IsLoaded()) {
+        fParisFastSimLibrary.Load(fParisFastSimLibraryFile);
+    }
+
     auto asmPARIS = new G4AssemblyVolume();
     G4RotationMatrix rotId;
     G4ThreeVector trHousing ( 193.*mm, 0., 230.5*mm );
@@ -644,6 +830,7 @@ G4VPhysicalVolume *MyDetectorConstruction::Construct()
     
     //const G4double D_frontCe = 207.5*mm; // test d'après le GDML fourni
     const G4double Rtarget   = 300.0*mm;
+    fParisRoutes.clear();
     for (auto theta : thetas) {
         const G4double phi_loc = theta;
         G4ThreeVector r_local(std::cos(phi_loc), std::sin(phi_loc), 0.);
@@ -677,6 +864,9 @@ G4VPhysicalVolume *MyDetectorConstruction::Construct()
             << G4endl;
         G4Transform3D T(R, pos);
         asmPARIS->MakeImprint(logicWorld, T, copyNo, checkOverlaps);
+        RegisterParisImprint(asmPARIS, lvCe, lvNaI, copyNo); // copyNo = index PARIS 0..8
+        fParisFaceCentres[copyNo] = faceCeWorld;             // cible de /tetra/gen/coneTarget
+        fParisAxes[copyNo] = w;                              // z local du Ce (rotation identité dans l'assembly)
         
         G4cout << "dist(faceCeWorld) = " << faceCeWorld.mag()/mm << " mm" << G4endl;
 
@@ -740,6 +930,9 @@ G4VPhysicalVolume *MyDetectorConstruction::Construct()
         
     }
 
+    // ====== Régions : coupures + désexcitation ======
+    ConfigureRegions();
+
     // ====== Retour ======
     return physWorld;
 }
@@ -752,9 +945,9 @@ void MyDetectorConstruction::ConstructSDandField()
     auto lvCe  = G4LogicalVolumeStore::GetInstance()->GetVolume("SCIONIXPWLVCe");
     auto lvNaI = G4LogicalVolumeStore::GetInstance()->GetVolume("SCParisPWLV.1");
 
-    // depth=0 => copyNo du volume sensible (Ce/NaI) lui-même (ça colle avec ce que tu lisais dans la HitsMap)
-    auto sdCe  = new CrystalSD("CeCrystalSD",  "CeCrystalHits",  /*copyDepth=*/0);
-    auto sdNaI = new CrystalSD("NaICrystalSD", "NaICrystalHits", /*copyDepth=*/0);
+    // Index PARIS résolu par la table de routage construite dans Construct
+    auto sdCe  = new CrystalSD("CeCrystalSD",  &fParisRoutes);
+    auto sdNaI = new CrystalSD("NaICrystalSD", &fParisRoutes);
 
     sdMan->AddNewDetector(sdCe);
     sdMan->AddNewDetector(sdNaI);
@@ -762,16 +955,23 @@ void MyDetectorConstruction::ConstructSDandField()
     if (lvCe)  lvCe->SetSensitiveDetector(sdCe);
     if (lvNaI) lvNaI->SetSensitiveDetector(sdNaI);
 
+    // Fast-sim PARIS : un modèle par thread, dépôts écrits dans les SD ci-dessus
+    if (fParisFastSim) {
+        if (fParisRegion && fParisFastSimLibrary.IsLoaded()) {
+            new ParisFastSimModel("ParisFastSim", fParisRegion, &fParisFastSimLibrary,
+                                  &fParisRoutes, sdCe, sdNaI, fParisFastSimMaxAngle);
+        } else {
+            G4Exception("MyDetectorConstruction::ConstructSDandField","NoFastSimLibrary",
+                        JustWarning, "Bibliothèque fast-sim PARIS absente : tracking complet.");
+        }
+    }
+
     // ===============================
-    // Cells : inchangé
+    // Cells He3 : entrées + capture n+3He (anneau/tube depuis copy number)
     // ===============================
-    auto sdCell = new G4MultiFunctionalDetector("CellSD");
+    auto sdCell = new He3CellSD("He3CellSD", &fCells, fKillHe3Products);
     sdMan->AddNewDetector(sdCell);
 
-    auto psEnter = new G4PSTrackCounter("nThermalEnter", fCurrent_In);
-    //psEnter->SetFilter(filterThermalN);
-    sdCell->RegisterPrimitive(psEnter);
-
     if (fScoringVolumeOne)   fScoringVolumeOne->SetSensitiveDetector(sdCell);
     if (fScoringVolumeTwo)   fScoringVolumeTwo->SetSensitiveDetector(sdCell);
     if (fScoringVolumeThree) fScoringVolumeThree->SetSensitiveDetector(sdCell);
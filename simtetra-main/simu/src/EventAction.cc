@@ -1,273 +1,278 @@
 #include "EventAction.hh"
 #include "RunAction.hh"
-#include "DetectorConstruction.hh"
+#include "PrimaryGenerator.hh"
 #include "CrystalSD.hh"
+#include "He3CellSD.hh"
+#include "ParisResolution.hh"
+#include "ParisStream.hh"
 
-#include "G4RunManager.hh"
 #include "G4Event.hh"
-#include "G4HCofThisEvent.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
 #include "G4SDManager.hh"
-#include "G4THitsMap.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4AnalysisManager.hh"
 #include "Randomize.hh"
-#include "G4PrimaryVertex.hh"
-#include "G4PrimaryParticle.hh"
-#include "G4ParticleDefinition.hh"
 
-#include <unordered_map>
-#include <map>
+#include <array>
 #include <cmath>
-#include <limits>
-
-// Méthodes pour compter les hits par ring
-void MyEventAction::AddHitToRing(G4int ringNumber) {
-  switch (ringNumber) {
-    case 1: fHitsRing1++; break;
-    case 2: fHitsRing2++; break;
-    case 3: fHitsRing3++; break;
-    case 4: fHitsRing4++; break;
-    default: break;
-  }
-}
 
-void MyEventAction::ResetRingCounters() {
-  fHitsRing1 = 0;
-  fHitsRing2 = 0;
-  fHitsRing3 = 0;
-  fHitsRing4 = 0;
-}
-
-// ---------- Paramètres de résolution par PARIS ----------
-struct ResParams { double resA; double resPower; };
-
-// Avec les copy number
-static const std::map<int, ResParams> parisRes = { // run du 05/08/2024
-    {0,  {1.12145,  -0.441244}},
-    {1,  {1.80973,  -0.550685}},
-    {2,  {1.94868,  -0.564616}},
-    {3,  {2.11922,  -0.582147}},
-    {4,  {0.794233, -0.377311}},
-    {5,  {1.30727,  -0.477402}},
-    {6,  {1.76345,  -0.542769}},
-    {7,  {1.98579,  -0.559095}},
-    {8,  {1.9886,   -0.574021}}
-};
-
-// Récupère l'énergie du premier gamma primaire de l'évènement (en keV)
-static G4double GetPrimaryGammaEnergyKeV(const G4Event* evt) {
-  if (!evt) return 0.0;
-  for (G4int iv = 0; iv < evt->GetNumberOfPrimaryVertex(); ++iv) {
-    auto* vtx = evt->GetPrimaryVertex(iv);
-    if (!vtx) continue;
-    for (G4int ip = 0; ip < vtx->GetNumberOfParticle(); ++ip) {
-      auto* pp = vtx->GetPrimary(ip);
-      if (!pp) continue;
-      auto* def = pp->GetParticleDefinition();
-      if (def && def->GetParticleName() == "gamma") {
-        return pp->GetKineticEnergy()/keV; // → keV
-      }
-    }
-  }
-  return 0.0;
-}
+static_assert(kNParis <= 16, "fTouchedMask (uint16) trop petit pour kNParis");
 
 namespace {
-  struct ParisAcc {
-    G4double eCe_keV   = 0.0;
-    G4double eNaI_keV  = 0.0;
-    G4double tFirstCe_ns  = -1.0; // -1 si aucun dépôt
-    G4double tFirstNaI_ns = -1.0;
-  };
-
   inline void UpdateTFirst(G4double& tFirst, G4double tCand) {
     if (tCand < 0.0) return;
     if (tFirst < 0.0 || tCand < tFirst) tFirst = tCand;
   }
-
-  // Somme d'une HitsMap<G4double> (pour CellSD)
-  G4double SumHitsMap(const G4THitsMap<G4double>* hm) {
-    if (!hm) return 0.;
-    G4double s = 0.;
-    for (const auto& kv : *hm->GetMap()) {
-      if (kv.second) s += *(kv.second);
-    }
-    return s;
-  }
 }
 
 // ====== ctor cohérent avec le .hh ======
-MyEventAction::MyEventAction(MyRunAction* runAction)
-: fRunAction(runAction) {}
+MyEventAction::MyEventAction(MyRunAction* runAction, const MyPrimaryGenerator* generator,
+                             RunMode mode)
+: fRunAction(runAction), fGenerator(generator)
+{
+  switch (mode) {
+    case RunMode::GammaResponse:
+      fProcessEvent = &MyEventAction::ProcessEvent<RunModePolicy::GammaResponse>;     break;
+    case RunMode::SourceSpectra:
+      fProcessEvent = &MyEventAction::ProcessEvent<RunModePolicy::SourceSpectra>;     break;
+    case RunMode::NeutronEfficiency:
+      fProcessEvent = &MyEventAction::ProcessEvent<RunModePolicy::NeutronEfficiency>; break;
+    default:
+      fProcessEvent = &MyEventAction::ProcessEvent<RunModePolicy::Full>;              break;
+  }
+}
 
-// Résolution "lazy" des IDs des hits collections (1re fois)
-void MyEventAction::BeginOfEventAction(const G4Event* /*evt*/) {
-  ResetRingCounters();
+// Résolution des pointeurs du run (1 fois par run, pas par évènement)
+void MyEventAction::BeginOfRun() {
+  fAnalysisManager = G4AnalysisManager::Instance();
+  fRespNtupleId    = fRunAction ? fRunAction->TruthRespNtupleId() : -1;
+  fSparse              = fRunAction && fRunAction->IsSparseOutput();
+  fSparseThreshold_keV = fRunAction ? fRunAction->SparseThreshold()/keV : 0.0;
+  fNtuples             = !fRunAction || fRunAction->IsNtupleOutput();
+  fSmearing            = !fRunAction || fRunAction->IsSmearing();
+  fStream              = fRunAction ? fRunAction->StreamWriter() : nullptr;
+  const G4Run* run     = G4RunManager::GetRunManager()->GetCurrentRun();
+  fRunID               = run ? run->GetRunID() : 0;
+  for (G4int idx = 0; idx < kNParis; ++idx) {
+    fRespRawH2Id[idx]     = fRunAction ? fRunAction->RespH2Id(idx, false) : -1;
+    fRespSmearedH2Id[idx] = fRunAction ? fRunAction->RespH2Id(idx, true)  : -1;
+    fRespFineH2Id[idx]    = fRunAction ? fRunAction->RespFineH2Id(idx)    : -1;
+    fGenH1Id[idx]         = fRunAction ? fRunAction->GenH1Id(idx)         : -1;
+  }
 
-  if (fHCID_CeEdep < 0) {
-    auto* sdm = G4SDManager::GetSDMpointer();
+  auto* sdm = G4SDManager::GetSDMpointer();
 
-    // >>> NOMS CrystalSD (doivent matcher ConstructSDandField) <<<
-    fHCID_CeEdep  = sdm->GetCollectionID("CeCrystalSD/CeCrystalHits");
-    fHCID_NaIEdep = sdm->GetCollectionID("NaICrystalSD/NaICrystalHits");
+  // >>> NOMS CrystalSD (doivent matcher ConstructSDandField) <<<
+  fCeSD  = dynamic_cast<const CrystalSD*>(sdm->FindSensitiveDetector("CeCrystalSD",  false));
+  fNaISD = dynamic_cast<const CrystalSD*>(sdm->FindSensitiveDetector("NaICrystalSD", false));
 
-    // CellSD inchangé
-    fHCID_CellIn  = sdm->GetCollectionID("CellSD/nThermalEnter");
+  fHe3SD = dynamic_cast<const He3CellSD*>(sdm->FindSensitiveDetector("He3CellSD", false));
 
-    if (fHCID_CeEdep < 0 || fHCID_NaIEdep < 0 || fHCID_CellIn < 0) {
-      G4Exception("MyEventAction::BeginOfEventAction","MissingHCID", JustWarning,
-                  "Au moins une hits collection introuvable. Vérifie les noms.");
-    }
+  if (!fCeSD || !fNaISD || !fHe3SD) {
+    G4Exception("MyEventAction::BeginOfRun","MissingSD", JustWarning,
+                "Au moins un SD introuvable. Vérifie les noms.");
   }
 }
 
-void MyEventAction::EndOfEventAction(const G4Event* evt) {
-  auto* man = G4AnalysisManager::Instance();
-  auto* hcevt = evt->GetHCofThisEvent();
-
-  // 1) CellSD : compteur neutron (HitsMap)
-  G4double nIn = 0.0;
-  if (hcevt && fHCID_CellIn >= 0) {
-    auto* hmCell = static_cast<G4THitsMap<G4double>*>(hcevt->GetHC(fHCID_CellIn));
-    nIn = SumHitsMap(hmCell);
+void MyEventAction::BeginOfEventAction(const G4Event* /*evt*/) {
+  // Remise à zéro des seuls accumulateurs touchés à l'évènement précédent
+  for (G4int idx = 0; fTouchedMask != 0 && idx < kNParis; ++idx) {
+    if (fTouchedMask & (1u << idx)) fAcc[idx] = ParisAcc{};
   }
+  fTouchedMask = 0;
+}
 
-  // 2) Récupérer collections Crystal
-  auto* hcCe  = (hcevt && fHCID_CeEdep  >= 0) ? static_cast<CrystalHitsCollection*>(hcevt->GetHC(fHCID_CeEdep))  : nullptr;
-  auto* hcNaI = (hcevt && fHCID_NaIEdep >= 0) ? static_cast<CrystalHitsCollection*>(hcevt->GetHC(fHCID_NaIEdep)) : nullptr;
+void MyEventAction::EndOfEventAction(const G4Event* evt) {
+  if (!fAnalysisManager) return; // BeginOfRun non appelé
+  (this->*fProcessEvent)(evt);
+}
 
-  // Accumulateurs par idx (ton mapping inchangé)
-  std::unordered_map<int, ParisAcc> byParisIndex;
+// Traitement d'un évènement, instancié par mode (RunMode.hh) : les blocs
+// "if constexpr" d'un mode désactivé ne sont pas compilés dans son instance.
+template <class Mode>
+void MyEventAction::ProcessEvent(const G4Event* evt) {
+  auto* man = fAnalysisManager;
+  const G4int eventID = evt->GetEventID();
+
+  // 1) He3CellSD : entrées dans le gaz + captures par anneau
+  [[maybe_unused]] G4double nIn = 0.0;
+  if constexpr (Mode::kNeutron) {
+    nIn = fHe3SD ? fHe3SD->GetNEnter() : 0.0;
+  }
 
   // Totaux évènement pour ntuple #0
-  G4double eCe_evt_MeV  = 0.0;
-  G4double eNaI_evt_MeV = 0.0;
-
-  // ---- Ce ----
-  if (hcCe) {
-    for (size_t i = 0; i < hcCe->GetSize(); ++i) {
-      const auto* hit = (*hcCe)[i];
-      if (!hit) continue;
-
-      const int copy = hit->GetCopyNo();
-
-      // >>> LOGIQUE INDICES INCHANGEE <<<
-      // int idx = copy - 3;
-      // if (idx == 21) idx = 8;
-      // if (idx < 0) continue;
-      int idx = copy -1; //pour garder paris de 0 à 8
-      // DEBUG sécurité
-      //std::cout<<"DEBUG Ce copyNo="<<copy<<" idx="<<idx<<std::endl;
-      if (idx < 0 || idx > 8) std::cout<<"DEBUG CeBr3 idx ="<< idx<<std::endl;   // sécurité
-      const G4double eMeV   = hit->GetEdep();   // MeV
-      const G4double tFirst = hit->GetTFirst(); // ns
-
-      eCe_evt_MeV += eMeV;
-
-      byParisIndex[idx].eCe_keV += eMeV/keV;
-      UpdateTFirst(byParisIndex[idx].tFirstCe_ns, tFirst);
+  [[maybe_unused]] G4double eCe_evt_MeV  = 0.0;
+  [[maybe_unused]] G4double eNaI_evt_MeV = 0.0;
+  G4int nRowsWritten = 0, nRowsSuppressed = 0;
+
+  if constexpr (Mode::kParis) {
+    // 2) Slots cristaux touchés (index PARIS déjà résolu par CrystalSD)
+    // ---- Ce ----
+    if (fCeSD) {
+      for (G4int i = 0; i < fCeSD->GetNTouched(); ++i) {
+        const int idx = fCeSD->GetTouched(i);
+        const auto& hit = fCeSD->GetSlot(idx);
+        const G4double eMeV   = hit.GetEdep();   // MeV
+        const G4double tFirst = hit.GetTFirst(); // ns
+
+        eCe_evt_MeV += eMeV;
+
+        fAcc[idx].eCe_keV += eMeV/keV;
+        UpdateTFirst(fAcc[idx].tFirstCe_ns, tFirst);
+        fTouchedMask |= (1u << idx);
+      }
     }
-  }
 
-  // ---- NaI ----
-  if (hcNaI) {
-    for (size_t i = 0; i < hcNaI->GetSize(); ++i) {
-      const auto* hit = (*hcNaI)[i];
-      if (!hit) continue;
-
-      const int copy = hit->GetCopyNo();
-
-      // >>> LOGIQUE INDICES INCHANGEE <<<
-      // int idx = copy - 4;
-      // if (idx == 21) idx = 8;
-      // if (idx < 0) continue;
-      int idx = copy-1; //pour garder paris de 0 à 8
-      if (idx < 0 || idx > 8) std::cout<<"DEBUG NaI idx ="<< idx<<std::endl;   // sécurité
-      // DEBUG sécurité
-      //std::cout<<"DEBUG NaI copyNo="<<copy<<" idx="<<idx<<std::endl;
-      const G4double eMeV   = hit->GetEdep();
-      const G4double tFirst = hit->GetTFirst();
-
-      eNaI_evt_MeV += eMeV;
-
-      byParisIndex[idx].eNaI_keV += eMeV/keV;
-      UpdateTFirst(byParisIndex[idx].tFirstNaI_ns, tFirst);
-    }
-  }
+    // ---- NaI ----
+    if (fNaISD) {
+      for (G4int i = 0; i < fNaISD->GetNTouched(); ++i) {
+        const int idx = fNaISD->GetTouched(i);
+        const auto& hit = fNaISD->GetSlot(idx);
+        const G4double eMeV   = hit.GetEdep();
+        const G4double tFirst = hit.GetTFirst();
 
-  // Énergie primaire gamma (keV)
-  const double Etrue_keV_evt = GetPrimaryGammaEnergyKeV(evt);
+        eNaI_evt_MeV += eMeV;
 
-  // Labels (si tu en as besoin)
-  const auto* det = static_cast<const MyDetectorConstruction*>(
-      G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+        fAcc[idx].eNaI_keV += eMeV/keV;
+        UpdateTFirst(fAcc[idx].tFirstNaI_ns, tFirst);
+        fTouchedMask |= (1u << idx);
+      }
+    }
 
-  // 3) Remplissage par idx (ntuple #3, #4, #5)
-  for (const auto& it : byParisIndex) {
-    const int idx = it.first;
-    const ParisAcc& A = it.second;
+    // Énergie primaire gamma (keV), transmise par le générateur
+    [[maybe_unused]] const double Etrue_keV_evt = fGenerator ? fGenerator->GetTrueEnergy()/keV : 0.0;
+    [[maybe_unused]] const G4int  trueBin       = fGenerator ? fGenerator->GetTrueBin() : -1;
+    // Émission en cône : fraction d'angle solide (1 en isotrope). Les réponses sont
+    // pondérées, hGen ne l'est pas : réponse / hGen = efficacité par photon 4π.
+    [[maybe_unused]] const G4double weight      = fGenerator ? fGenerator->GetEventWeight() : 1.0;
+
+    // Énergies générées (dénominateur de l'efficacité, par binning PARIS)
+    if constexpr (Mode::kResponse) {
+      for (G4int idx = 0; idx < kNParis; ++idx) {
+        if (fGenH1Id[idx] >= 0) man->FillH1(fGenH1Id[idx], Etrue_keV_evt);
+      }
+    }
 
-    const double Ece_keV  = A.eCe_keV;
-    const double Enai_keV = A.eNaI_keV;
+    // 3) Remplissage par idx touché (ntuple #3, #4, #5)
+    // En mode sparse, les PARIS sous le seuil (Ce + NaI) ne sont pas écrits ;
+    // seul leur nombre est compté (RunMeta).
+    for (G4int idx = 0; fTouchedMask != 0 && idx < kNParis; ++idx) {
+      if (!(fTouchedMask & (1u << idx))) continue;
+      const ParisAcc& A = fAcc[idx];
+
+      const double Ece_keV  = A.eCe_keV;
+      const double Enai_keV = A.eNaI_keV;
+      const G4bool belowThreshold = fSparse && (Ece_keV + Enai_keV) <= fSparseThreshold_keV;
+
+      // ===== Smearing Ce (optionnel : sinon Emeas = dépôt brut, repli par FoldResolution.C) =====
+      [[maybe_unused]] double eResCe_keV = Ece_keV;
+
+      if constexpr (Mode::kResponse) {
+        if (fSmearing && Ece_keV > 0.0) {
+          const ParisResParams& P = kParisRes[idx];
+          const double resolution_Ce = P.resA * std::pow(Ece_keV, P.resPower);
+          const double sigma_Ce      = (resolution_Ce / 2.35) * Ece_keV;
+          eResCe_keV = G4RandGauss::shoot(Ece_keV, sigma_Ce);
+        }
+
+        // ===== Matrices de réponse (X = Emeas, Y = Etrue), indépendantes du mode sparse =====
+        if (fRespRawH2Id[idx] >= 0)     man->FillH2(fRespRawH2Id[idx], Ece_keV, Etrue_keV_evt, weight);
+        if (fSmearing && fRespSmearedH2Id[idx] >= 0) {
+          man->FillH2(fRespSmearedH2Id[idx], eResCe_keV, Etrue_keV_evt, weight);
+        }
+        // Ce nul (NaI seul) rangé dans l'underflow : FoldResolution.C l'envoie, non smearé, au bin mesuré 1
+        if (fRespFineH2Id[idx] >= 0) {
+          man->FillH2(fRespFineH2Id[idx], (Ece_keV > 0.0) ? Ece_keV : -1.0, Etrue_keV_evt, weight);
+        }
+
+        // ===== Flux binaire : un enregistrement de 32 o par PARIS touché =====
+        if (fStream && fStream->IsOpen() && !belowThreshold) {
+          ParisStream::Record rec{};
+          rec.det       = static_cast<std::uint8_t>(idx);
+          rec.trueBin   = trueBin;
+          rec.eCe_keV   = static_cast<float>(Ece_keV);
+          rec.eNaI_keV  = static_cast<float>(Enai_keV);
+          rec.tCe_ns    = static_cast<float>(A.tFirstCe_ns);
+          rec.tNaI_ns   = static_cast<float>(A.tFirstNaI_ns);
+          rec.eTrue_keV = static_cast<float>(Etrue_keV_evt);
+          rec.weight    = static_cast<float>(weight);
+          fStream->Add(fRunID, eventID, rec);
+        }
+      }
 
-    // ===== Smearing Ce (inchangé) =====
-    double eResCe_keV  = Ece_keV;
-    double eResNaI_keV = Enai_keV;
+      if (!fNtuples) continue;
+      if (belowThreshold) {
+        ++nRowsSuppressed;
+        continue;
+      }
+      ++nRowsWritten;
+
+      // ===== Ntuple #3 : ParisEdep (eventID, copy(idx), eCe_keV, eNaI_keV) =====
+      // >>> Hors mode sparse : on remplit TOUJOURS (même 0) <<<
+      if constexpr (Mode::kSpectra) {
+        man->FillNtupleIColumn(3, 0, eventID);
+        man->FillNtupleIColumn(3, 1, idx);
+        man->FillNtupleDColumn(3, 2, Ece_keV);
+        man->FillNtupleDColumn(3, 3, Enai_keV);
+        man->FillNtupleIColumn(3, 4, fRunID);
+        man->AddNtupleRow(3);
+      }
 
-    auto prm = parisRes.find(idx);
-    if (prm != parisRes.end()) {
-      const ResParams& P = prm->second;
-      if (Ece_keV > 0.0) {
-        const double resolution_Ce = P.resA * std::pow(Ece_keV, P.resPower);
-        const double sigma_Ce      = (resolution_Ce / 2.35) * Ece_keV;
-        eResCe_keV = G4RandGauss::shoot(Ece_keV, sigma_Ce);
+      // ===== Ntuple #4 : resp (inchangé) =====
+      if constexpr (Mode::kResponse) {
+        const G4int ntResp = fRespNtupleId;
+        if (ntResp >= 0) {
+          man->FillNtupleIColumn(ntResp, 0, eventID);
+          man->FillNtupleIColumn(ntResp, 1, idx);
+          man->FillNtupleDColumn(ntResp, 2, Etrue_keV_evt);
+          man->FillNtupleDColumn(ntResp, 3, eResCe_keV);
+          man->FillNtupleDColumn(ntResp, 4, Ece_keV);
+          man->FillNtupleDColumn(ntResp, 5, Enai_keV);
+          man->FillNtupleIColumn(ntResp, 6, trueBin);
+          man->FillNtupleDColumn(ntResp, 7, weight);
+          man->FillNtupleIColumn(ntResp, 8, fRunID);
+          man->AddNtupleRow(ntResp);
+        }
       }
-    } else {
-      // pas bloquant
-      const std::string& parisName = det->GetParisLabel(idx);
-      G4Exception("MyEventAction::EndOfEventAction","ParamsNotFound", JustWarning,
-                  ("Pas de paramètres de résolution pour " + parisName).c_str());
-    }
 
-    // ===== Ntuple #3 : ParisEdep (eventID, copy(idx), eCe_keV, eNaI_keV) =====
-    // >>> IMPORTANT : on remplit TOUJOURS (même 0) <<<
-    man->FillNtupleIColumn(3, 0, evt->GetEventID());
-    man->FillNtupleIColumn(3, 1, idx);
-    man->FillNtupleDColumn(3, 2, Ece_keV);
-    man->FillNtupleDColumn(3, 3, Enai_keV);
-    man->AddNtupleRow(3);
-
-    // ===== Ntuple #4 : resp (inchangé) =====
-    const G4int ntResp = fRunAction->TruthRespNtupleId();
-    if (ntResp >= 0) {
-      man->FillNtupleIColumn(ntResp, 0, evt->GetEventID());
-      man->FillNtupleIColumn(ntResp, 1, idx);
-      man->FillNtupleDColumn(ntResp, 2, Etrue_keV_evt);
-      man->FillNtupleDColumn(ntResp, 3, eResCe_keV);
-      man->FillNtupleDColumn(ntResp, 4, Ece_keV);
-      man->FillNtupleDColumn(ntResp, 5, Enai_keV);
-      man->AddNtupleRow(ntResp);
+      // ===== Ntuple #5 : paris_time (eventID, idx, Ece, Enai, tFirstCe, tFirstNaI) =====
+      // >>> tFirst = -1 si pas de dépôt (on écrit quand même) <<<
+      if constexpr (Mode::kSpectra) {
+        man->FillNtupleIColumn(5, 0, eventID);
+        man->FillNtupleIColumn(5, 1, idx);
+        man->FillNtupleDColumn(5, 2, Ece_keV);
+        man->FillNtupleDColumn(5, 3, Enai_keV);
+        man->FillNtupleDColumn(5, 4, A.tFirstCe_ns);
+        man->FillNtupleDColumn(5, 5, A.tFirstNaI_ns);
+        man->FillNtupleIColumn(5, 6, fRunID);
+        man->AddNtupleRow(5);
+      }
     }
-
-    // ===== Ntuple #5 : paris_time (eventID, idx, Ece, Enai, tFirstCe, tFirstNaI) =====
-    // >>> tFirst = -1 si pas de dépôt (on écrit quand même) <<<
-    man->FillNtupleIColumn(5, 0, evt->GetEventID());
-    man->FillNtupleIColumn(5, 1, idx);
-    man->FillNtupleDColumn(5, 2, Ece_keV);
-    man->FillNtupleDColumn(5, 3, Enai_keV);
-    man->FillNtupleDColumn(5, 4, A.tFirstCe_ns);
-    man->FillNtupleDColumn(5, 5, A.tFirstNaI_ns);
-    man->AddNtupleRow(5);
   }
 
   // 4) Ntuple #0 : Events (totaux par évènement)
-  man->FillNtupleIColumn(0, 0, evt->GetEventID());
-  man->FillNtupleDColumn(0, 1, nIn);
-  man->FillNtupleDColumn(0, 2, eCe_evt_MeV/keV);
-  man->FillNtupleDColumn(0, 3, eNaI_evt_MeV/keV);
-  man->FillNtupleIColumn(0, 4, fHitsRing1);
-  man->FillNtupleIColumn(0, 5, fHitsRing2);
-  man->FillNtupleIColumn(0, 6, fHitsRing3);
-  man->FillNtupleIColumn(0, 7, fHitsRing4);
-  man->AddNtupleRow(0);
-}
\ No newline at end of file
+  // En mode sparse : seulement si un PARIS a passé le seuil ou si une capture He3 a eu lieu
+  G4int nCaptures = 0;
+  if constexpr (Mode::kNeutron) {
+    for (G4int ring = 1; fHe3SD && ring <= 4; ++ring) nCaptures += fHe3SD->GetRingHits(ring);
+  }
+
+  const G4bool writeEvent = Mode::kEvents && fNtuples && (!fSparse || nRowsWritten > 0 || nCaptures > 0);
+  if (fRunAction) fRunAction->CountEvent(writeEvent, nRowsWritten, nRowsSuppressed);
+  if constexpr (Mode::kEvents) {
+    if (!writeEvent) return;
+
+    man->FillNtupleIColumn(0, 0, eventID);
+    man->FillNtupleDColumn(0, 1, nIn);
+    man->FillNtupleDColumn(0, 2, eCe_evt_MeV/keV);
+    man->FillNtupleDColumn(0, 3, eNaI_evt_MeV/keV);
+    for (G4int ring = 1; ring <= 4; ++ring) {
+      G4int hits = 0;
+      if constexpr (Mode::kNeutron) hits = fHe3SD ? fHe3SD->GetRingHits(ring) : 0;
+      man->FillNtupleIColumn(0, 3 + ring, hits);
+    }
+    man->FillNtupleIColumn(0, 8, fRunID);
+    man->AddNtupleRow(0);
+  }
+}
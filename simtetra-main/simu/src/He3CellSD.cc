@@ -0,0 +1,65 @@
+#include "He3CellSD.hh"
+
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4Neutron.hh"
+#include "G4Proton.hh"
+#include "G4Triton.hh"
+#include "G4ios.hh"
+
+He3CellSD::He3CellSD(const G4String& name, const He3CellTable* cells, G4bool killProducts)
+: G4VSensitiveDetector(name), fCells(cells), fKillProducts(killProducts)
+{
+  fCaptureTubes.reserve(8);
+}
+
+void He3CellSD::Initialize(G4HCofThisEvent* /*hce*/) {
+  fNEnter = 0;
+  fRingHits.fill(0);
+  fCaptureTubes.clear();
+}
+
+G4bool He3CellSD::ProcessHits(G4Step* step, G4TouchableHistory* /*history*/) {
+  if (!step) return false;
+  const auto* pre = step->GetPreStepPoint();
+
+  // Entrée dans le gaz (même logique que G4PSTrackCounter fCurrent_In)
+  if (pre->GetStepStatus() == fGeomBoundary) ++fNEnter;
+
+  // Réaction n + 3He : uniquement au pas d'interaction d'un neutron
+  // qui produit un triton (comparaison de pointeurs, pas de chaîne)
+  if (step->GetTrack()->GetDefinition() != G4Neutron::Definition()) return false;
+
+  const auto* secondaries = step->GetSecondaryInCurrentStep();
+  if (!secondaries || secondaries->empty()) return false;
+
+  const auto* triton = G4Triton::Definition();
+  G4bool captured = false;
+  for (const auto* sec : *secondaries) {
+    if (sec->GetDefinition() == triton) { captured = true; break; }
+  }
+  if (!captured) return false;
+
+  // Anneau / tube précalculés depuis le copy number de la cellule
+  const G4int copy = pre->GetTouchable()->GetCopyNumber();
+  if (!fCells || copy < 0 || copy >= (G4int)fCells->size()) return false;
+  const He3CellInfo& cell = (*fCells)[copy];
+  if (cell.ring < 1 || cell.ring > 4) return false;
+
+  ++fRingHits[cell.ring - 1];
+  fCaptureTubes.push_back(cell.tube);
+
+  // Option : le p et le t ne sont plus suivis (leur dépôt n'est pas scoré)
+  if (fKillProducts) {
+    const auto* proton = G4Proton::Definition();
+    for (const auto* sec : *secondaries) {
+      const auto* def = sec->GetDefinition();
+      if (def == triton || def == proton) {
+        const_cast<G4Track*>(sec)->SetTrackStatus(fStopAndKill);
+      }
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,136 @@
+#include "ParisFastSimModel.hh"
+#include "ParisResolution.hh"
+#include "CrystalSD.hh"
+
+#include "G4Gamma.hh"
+#include "G4Track.hh"
+#include "G4VTouchable.hh"
+#include "G4VSolid.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+// ---------- Bibliothèque ----------
+
+G4bool ParisFastSimLibrary::Load(const G4String& fileName)
+{
+  std::ifstream in(fileName);
+  if (!in) {
+    G4Exception("ParisFastSimLibrary::Load","NoFastSimLibrary", JustWarning,
+                ("Impossible d'ouvrir " + fileName).c_str());
+    return false;
+  }
+
+  for (G4int idx = 0; idx < kNParis; ++idx) {
+    for (auto& table : fTables[idx]) {
+      table.edges = BuildParisEdges(idx);
+      table.bins.assign(table.edges.size() - 1, {});
+    }
+  }
+  fNSamples = 0;
+
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream is(line);
+    G4int idx, crystal;
+    ParisFastSimSample s;
+    if (!(is >> idx >> crystal >> s.eInc_keV >> s.eCe_keV >> s.eNaI_keV >> s.dtCe_ns >> s.dtNaI_ns)) continue;
+    if (idx < 0 || idx >= kNParis || crystal < 0 || crystal > 1) continue;
+
+    Table& table = fTables[idx][crystal];
+    const auto it = std::upper_bound(table.edges.begin(), table.edges.end(), (G4double)s.eInc_keV);
+    const long bin = (it - table.edges.begin()) - 1;
+    if (bin < 0 || bin >= (long)table.bins.size()) continue;
+    table.bins[bin].push_back(s);
+    ++fNSamples;
+  }
+
+  G4cout << ">>> Bibliothèque fast-sim PARIS : " << fNSamples
+         << " échantillons lus dans " << fileName << G4endl;
+  return fNSamples > 0;
+}
+
+const ParisFastSimSample* ParisFastSimLibrary::Sample(G4int parisIndex, CrystalType crystal,
+                                                      G4double eInc) const
+{
+  const Table& table = fTables[parisIndex][static_cast<G4int>(crystal)];
+  const G4double e_keV = eInc/keV;
+  const auto it = std::upper_bound(table.edges.begin(), table.edges.end(), e_keV);
+  const long bin = (it - table.edges.begin()) - 1;
+  if (bin < 0 || bin >= (long)table.bins.size()) return nullptr;
+
+  const auto& samples = table.bins[bin];
+  if (samples.empty()) return nullptr;
+  const std::size_t k = std::min(samples.size() - 1, (std::size_t)(G4UniformRand()*samples.size()));
+  return &samples[k];
+}
+
+// ---------- Modèle ----------
+
+ParisFastSimModel::ParisFastSimModel(const G4String& name, G4Region* envelope,
+                                     const ParisFastSimLibrary* library,
+                                     const ParisRoutingTable* routes,
+                                     CrystalSD* sdCe, CrystalSD* sdNaI, G4double maxAngle)
+: G4VFastSimulationModel(name, envelope),
+  fLibrary(library), fRoutes(routes), fSdCe(sdCe), fSdNaI(sdNaI),
+  fCosMaxAngle(std::cos(maxAngle))
+{}
+
+G4bool ParisFastSimModel::IsApplicable(const G4ParticleDefinition& particle)
+{
+  return &particle == G4Gamma::Definition();
+}
+
+G4bool ParisFastSimModel::ModelTrigger(const G4FastTrack& fastTrack)
+{
+  fPending = nullptr;
+  if (!fLibrary || !fRoutes) return false;
+
+  // Uniquement un photon qui vient d'entrer par la frontière du cristal
+  // (pas les photons nés dedans, ni ceux qui sortent). Le déclenchement est
+  // évalué après CopyPostToPreStepPoint : l'état du point post-pas n'est plus
+  // défini, on teste la position sur l'enveloppe et la direction.
+  if (!fastTrack.OnTheBoundaryButEntering()) return false;
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+
+  // La bibliothèque ne décrit que des photons entrés par la face avant du Ce,
+  // proches de l'axe : face avant = normale sortante -z dans le repère du cristal
+  // (z local = axe du PARIS, vers le NaI)
+  const auto route = fRoutes->find(track->GetTouchable()->GetVolume());
+  if (route == fRoutes->end() || route->second.crystal != CrystalType::Ce) return false;
+  const G4ThreeVector localPos = fastTrack.GetPrimaryTrackLocalPosition();
+  if (fastTrack.GetEnvelopeSolid()->SurfaceNormal(localPos).z() > -0.999) return false;
+  if (fastTrack.GetPrimaryTrackLocalDirection().z() < fCosMaxAngle) return false;
+
+  fPending = fLibrary->Sample(route->second.parisIndex, route->second.crystal,
+                              track->GetKineticEnergy());
+  fPendingIndex = route->second.parisIndex;
+  return fPending != nullptr;   // hors couverture : tracking complet
+}
+
+void ParisFastSimModel::DoIt(const G4FastTrack& fastTrack, G4FastStep& fastStep)
+{
+  const G4Track* track = fastTrack.GetPrimaryTrack();
+  const ParisFastSimSample& s = *fPending;
+
+  // Dépôts mis à l'échelle de l'énergie incidente (échantillon du même bin résolution)
+  const G4double scale = (s.eInc_keV > 0.f) ? track->GetKineticEnergy()/(s.eInc_keV*keV) : 1.0;
+  const G4double eCe  = s.eCe_keV*keV*scale;
+  const G4double eNaI = s.eNaI_keV*keV*scale;
+  const G4double t0   = track->GetGlobalTime();
+
+  if (eCe  > 0.0 && fSdCe)  fSdCe ->AddDeposit(fPendingIndex, eCe,  t0 + s.dtCe_ns*ns);
+  if (eNaI > 0.0 && fSdNaI) fSdNaI->AddDeposit(fPendingIndex, eNaI, t0 + s.dtNaI_ns*ns);
+
+  // Pas de ProposeTotalEnergyDeposited : le gestionnaire de pas appellerait
+  // CrystalSD::ProcessHits sur le cristal du point pré-pas (dépôts comptés deux fois)
+  fastStep.KillPrimaryTrack();
+  fastStep.ProposePrimaryTrackPathLength(0.0);
+  fPending = nullptr;
+  fNFired.fetch_add(1, std::memory_order_relaxed);
+}
@@ -1,5 +1,6 @@
 #include "PhysicsList.hh"
 #include "NeutronHPphysics.hh"
+#include "DetectorConstruction.hh"
 
 #include "G4BosonConstructor.hh"
 #include "G4LeptonConstructor.hh"
@@ -9,18 +10,219 @@
 #include "G4IonConstructor.hh"
 #include "G4ShortLivedConstructor.hh"
 #include "G4EmStandardPhysics.hh"          
+#include "G4EmStandardPhysics_option4.hh"
+#include "G4EmLivermorePhysics.hh"
+#include "G4FastSimulationPhysics.hh"
 
 #include "G4SystemOfUnits.hh"
 #include "G4UnitsTable.hh"
 
+#include "G4GenericMessenger.hh"
+#include "G4Material.hh"
+#include "G4Element.hh"
+#include "G4RegionStore.hh"
+#include "G4RunManager.hh"
+#include "G4Region.hh"
+#include "G4ProductionCuts.hh"
+#include "G4EmParameters.hh"
+#include "G4StateManager.hh"
+#include "G4Threading.hh"
+#include "G4Version.hh"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <unistd.h>
+
 MyPhysicsList::MyPhysicsList()
 {	
-    RegisterPhysics(new G4DecayPhysics());
-    RegisterPhysics(new G4RadioactiveDecayPhysics());
     //RegisterPhysics(new G4EmStandardPhysics());
-
     RegisterPhysics(new G4EmPenelopePhysics());
-    //RegisterPhysics( new NeutronHPphysics("neutronHP"));
+
+    // Désintégrations / HP : enregistrés au passage en Init selon le profil
+    // (/tetra/physics/profile, défaut decay-source), cf. Notify.
+    // NeutronHPphysics (sans effet global) est créé ici pour que /testhadr/phys/
+    // existe avant /run/initialize ; il n'est enregistré qu'avec neutron | full.
+    fNeutronHP = new NeutronHPphysics("neutronHP");
+
+    // Cache des tables physiques (warm start), désactivé par défaut
+    if (const char* dir = std::getenv("TETRA_PHYS_CACHE"); dir && *dir) fCacheDir = dir;
+
+    fMessenger = new G4GenericMessenger(this, "/tetra/physics/", "Cache des tables physiques");
+    auto& cacheCmd = fMessenger->DeclareProperty("cacheDir", fCacheDir,
+        "Répertoire du cache des tables (vide = désactivé), avant /run/initialize");
+    cacheCmd.SetStates(G4State_PreInit);
+
+    // EM hybride : constructeur rapide partout, Penelope/Livermore dans PARISRegion
+    // (ex. emModel opt4 + parisEmModel penelope)
+    auto& emCmd = fMessenger->DeclareMethod("emModel", &MyPhysicsList::SetEmModel,
+        "Constructeur EM global : penelope (défaut) | livermore | opt4 | opt0");
+    emCmd.SetCandidates("penelope livermore opt4 opt0");
+    emCmd.SetStates(G4State_PreInit);
+    auto& parisEmCmd = fMessenger->DeclareProperty("parisEmModel", fParisEmModel,
+        "Modèles EM des cristaux PARIS (PARISRegion) : none (= global) | penelope | livermore");
+    parisEmCmd.SetCandidates("none penelope livermore");
+    parisEmCmd.SetStates(G4State_PreInit);
+
+    // Profil par type de job : ne construit que les processus utilisés
+    auto& profileCmd = fMessenger->DeclareMethod("profile", &MyPhysicsList::SetProfile,
+        "gamma-response (EM) | decay-source (EM + RDM, défaut) | neutron (EM + HP + S(a,b)) | full (EM + RDM + HP)");
+    profileCmd.SetCandidates("gamma-response decay-source neutron full");
+    profileCmd.SetStates(G4State_PreInit);
+}
+
+MyPhysicsList::~MyPhysicsList()
+{
+    delete fMessenger;
+    if (!fNeutronHPRegistered) delete fNeutronHP;   // sinon détruit avec la liste
+}
+
+// Le profil est seulement noté : G4RadioactiveDecayPhysics modifie G4EmParameters
+// et G4DeexPrecoParameters dès sa construction (Auger, désexcitation sans coupure),
+// et RemovePhysics ne défait pas ces réglages.
+void MyPhysicsList::SetProfile(G4String profile)
+{
+    fProfile = profile;
+}
+
+// PreInit -> Init (master, début de /run/initialize) : dernier moment où
+// RegisterPhysics est accepté, le profil est définitif.
+G4bool MyPhysicsList::Notify(G4ApplicationState requestedState)
+{
+    const G4ApplicationState current = G4StateManager::GetStateManager()->GetCurrentState();
+    if (current == G4State_PreInit && requestedState == G4State_Init && !fProfileBuilt) {
+        BuildProfile();
+    }
+    return true;
+}
+
+void MyPhysicsList::BuildProfile()
+{
+    fProfileBuilt = true;
+    const G4bool decay   = (fProfile == "decay-source" || fProfile == "full");
+    const G4bool neutron = (fProfile == "neutron"      || fProfile == "full");
+
+    if (decay) {
+        RegisterPhysics(new G4DecayPhysics());
+        RegisterPhysics(new G4RadioactiveDecayPhysics());
+    }
+    if (neutron) {
+        RegisterPhysics(fNeutronHP);
+        fNeutronHPRegistered = true;
+    }
+
+    // Paramétrisations (ParisFastSimModel) : processus ajouté à chaque pas de photon,
+    // seulement si /detector/parisFastSim true
+    const auto* detector = dynamic_cast<const MyDetectorConstruction*>(
+        G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    const G4bool fastSim = detector && detector->IsParisFastSim();
+    if (fastSim) {
+        auto* fastSimPhysics = new G4FastSimulationPhysics();
+        fastSimPhysics->ActivateFastSimulation("gamma");
+        RegisterPhysics(fastSimPhysics);
+    }
+
+    G4cout << ">>> Profil physique : " << fProfile << (fastSim ? " + fast-sim PARIS" : "") << G4endl;
+}
+
+void MyPhysicsList::SetEmModel(G4String model)
+{
+    // Même type de constructeur (électromagnétique) : ReplacePhysics remplace Penelope
+    if      (model == "livermore") ReplacePhysics(new G4EmLivermorePhysics());
+    else if (model == "opt4")      ReplacePhysics(new G4EmStandardPhysics_option4());
+    else if (model == "opt0")      ReplacePhysics(new G4EmStandardPhysics());
+    else                           ReplacePhysics(new G4EmPenelopePhysics());
+}
+
+// Les modèles de région sont installés par G4EmModelActivator à la construction
+// des processus : PARISRegion (MyDetectorConstruction::Construct) existe déjà.
+void MyPhysicsList::ConstructProcess()
+{
+    if (G4Threading::IsMasterThread() && fParisEmModel != "none") {
+        const G4String type = (fParisEmModel == "livermore") ? "G4EmLivermore" : "G4EmPenelope";
+        G4EmParameters::Instance()->AddPhysics("PARISRegion", type);
+        G4cout << ">>> EM : " << type << " dans PARISRegion" << G4endl;
+    }
+    G4VModularPhysicsList::ConstructProcess();
+}
+
+G4String MyPhysicsList::TableCacheKey() const
+{
+    std::ostringstream os;
+    os.precision(10);
+    os << G4Version << '|';
+
+    for (G4int i = 0; GetPhysics(i) != nullptr; ++i) os << GetPhysics(i)->GetPhysicsName() << ';';
+    os << "PARISRegion:" << fParisEmModel << ';';
+
+    auto* em = G4EmParameters::Instance();
+    os << '|' << em->MinKinEnergy() << ';' << em->MaxKinEnergy() << ';'
+       << em->NumberOfBinsPerDecade() << ';' << em->LowestElectronEnergy();
+
+    // Coupures (défaut + régions) : la table des couples matériau-coupure en dépend
+    os << '|' << GetDefaultCutValue();
+    for (const auto* region : *G4RegionStore::GetInstance()) {
+        const auto* cuts = region->GetProductionCuts();
+        os << ';' << region->GetName();
+        if (cuts) for (G4int j = 0; j < 4; ++j) os << ',' << cuts->GetProductionCut(j);
+    }
+
+    // Matériaux définis par MyDetectorConstruction::Construct (+ GDML)
+    for (const auto* mat : *G4Material::GetMaterialTable()) {
+        os << '|' << mat->GetName() << ';' << mat->GetDensity() << ';' << mat->GetState();
+        const auto* fractions = mat->GetFractionVector();
+        for (size_t j = 0; j < mat->GetNumberOfElements(); ++j) {
+            os << ';' << mat->GetElement(j)->GetZ() << ':' << fractions[j];
+        }
+    }
+
+    std::ostringstream key;
+    key << std::hex << std::hash<std::string>{}(os.str());
+    return key.str();
+}
+
+// Appelé dans /run/initialize après la géométrie : matériaux et régions existent
+void MyPhysicsList::SetCuts()
+{
+    G4VModularPhysicsList::SetCuts();
+
+    fStoreCache = false;
+    if (fCacheDir.empty() || !G4Threading::IsMasterThread()) return;
+
+    fCacheKeyDir = fCacheDir + "/" + TableCacheKey();
+    if (std::filesystem::exists(fCacheKeyDir + "/complete")) {
+        G4cout << ">>> Tables physiques relues depuis " << fCacheKeyDir << G4endl;
+        SetPhysicsTableRetrieved(fCacheKeyDir);
+    } else {
+        G4cout << ">>> Cache des tables absent, il sera écrit dans " << fCacheKeyDir << G4endl;
+        fStoreCache = true;
+    }
+}
+
+void MyPhysicsList::StoreTableCache()
+{
+    if (!fStoreCache) return;
+    fStoreCache = false;
+
+    // Écriture dans un répertoire temporaire puis rename : plusieurs
+    // processus du batch peuvent remplir la même clé en parallèle.
+    namespace fs = std::filesystem;
+    const G4String tmpDir = fCacheKeyDir + ".tmp" + std::to_string(::getpid());
+    std::error_code ec;
+    fs::create_directories(tmpDir, ec);
+    if (ec || !StorePhysicsTable(tmpDir)) {
+        G4Exception("MyPhysicsList::StoreTableCache","CacheWriteFailed", JustWarning,
+                    ("Impossible d'écrire le cache dans " + tmpDir).c_str());
+        fs::remove_all(tmpDir, ec);
+        return;
+    }
+    std::ofstream(tmpDir + "/complete") << G4Version << G4endl;
+
+    fs::rename(tmpDir, fCacheKeyDir, ec);
+    if (ec) fs::remove_all(tmpDir, ec);  // un autre processus a gagné
+    else G4cout << ">>> Cache des tables physiques écrit : " << fCacheKeyDir << G4endl;
 }
 
 void MyPhysicsList::ConstructParticle()
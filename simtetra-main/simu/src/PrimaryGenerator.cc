@@ -1,18 +1,265 @@
 #include "PrimaryGenerator.hh"
+#include "ParisResolution.hh"
+#include "DetectorConstruction.hh"
 #include "G4GeneralParticleSource.hh"
+#include "G4GenericMessenger.hh"
 #include "G4Event.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4Gamma.hh"
+#include "G4RunManager.hh"
+#include "G4PhysicalConstants.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
 
 MyPrimaryGenerator::MyPrimaryGenerator()
 {
   fGPS = new G4GeneralParticleSource();
+
+  fMessenger = new G4GenericMessenger(this, "/tetra/gen/", "Énergie primaire (scan de réponse)");
+  fMessenger->DeclareMethod("energyMode", &MyPrimaryGenerator::SetEnergyMode,
+                            "gps | discrete | uniform")
+    .SetCandidates("gps discrete uniform");
+  fMessenger->DeclareMethod("energyList", &MyPrimaryGenerator::LoadEnergyList,
+                            "Liste d'énergies (keV) : /control/alias Elist { ... } ou une valeur par ligne");
+  fMessenger->DeclareMethod("parisEdges", &MyPrimaryGenerator::UseParisEdges,
+                            "Bins résolution du PARIS d'index donné (0..8) au lieu d'une liste");
+  fMessenger->DeclareMethod("coneTarget", &MyPrimaryGenerator::SetConeTarget,
+                            "Émission en cône vers un PARIS : off | 0..8 | all (poids = angle solide / 4π)");
+  fMessenger->DeclarePropertyWithUnit("coneHalfAngle", "deg", fConeHalfAngle,
+                                      "Demi-angle du cône d'émission (doit couvrir tout le cristal)");
+  fMessenger->DeclareMethod("faceBeam", &MyPrimaryGenerator::SetFaceBeam,
+                            "Pencil sur la face Ce d'un PARIS, le long de son axe : off | 0..8 (BuildFastSimLibrary.C)");
 }
 
 MyPrimaryGenerator::~MyPrimaryGenerator()
 {
+  delete fMessenger;
   delete fGPS;
 }
 
+void MyPrimaryGenerator::SetEnergyMode(const G4String& mode)
+{
+  if      (mode == "discrete") fEnergyMode = EnergyMode::Discrete;
+  else if (mode == "uniform")  fEnergyMode = EnergyMode::Uniform;
+  else                         fEnergyMode = EnergyMode::GPS;
+}
+
+// Format macro : /control/alias Elist { 5.5 13.44 ... } ou une valeur par ligne (# = commentaire)
+std::vector<G4double> MyPrimaryGenerator::ReadEnergyList(const G4String& fileName)
+{
+  std::vector<G4double> energies;
+  std::ifstream in(fileName);
+  if (!in) {
+    G4Exception("MyPrimaryGenerator::ReadEnergyList","NoEnergyList", JustWarning,
+                ("Impossible d'ouvrir " + fileName).c_str());
+    return energies;
+  }
+  std::stringstream buf;
+  buf << in.rdbuf();
+  std::string content = buf.str();
+
+  const auto open = content.find('{');
+  const auto close = content.find('}', open == std::string::npos ? 0 : open);
+  if (open != std::string::npos && close != std::string::npos) {
+    content = content.substr(open + 1, close - open - 1);
+  }
+
+  std::istringstream lines(content);
+  std::string line;
+  while (std::getline(lines, line)) {
+    line = line.substr(0, line.find('#'));   // commentaires
+    std::istringstream tok(line);
+    G4double e;
+    while (tok >> e) energies.push_back(e);
+  }
+
+  if (energies.empty()) {
+    G4Exception("MyPrimaryGenerator::ReadEnergyList","EmptyEnergyList", JustWarning,
+                ("Aucune énergie lue dans " + fileName).c_str());
+  }
+  return energies;
+}
+
+void MyPrimaryGenerator::LoadEnergyList(const G4String& fileName)
+{
+  std::vector<G4double> energies = ReadEnergyList(fileName);
+  if (energies.empty()) return;
+  fCenters = std::move(energies);
+  SetBinsFromCenters();
+  G4cout << ">>> /tetra/gen : " << fCenters.size() << " énergies lues dans " << fileName << G4endl;
+}
+
+void MyPrimaryGenerator::UseParisEdges(G4int parisIndex)
+{
+  if (parisIndex < 0 || parisIndex >= kNParis) {
+    G4Exception("MyPrimaryGenerator::UseParisEdges","BadParisIndex", JustWarning,
+                "Index PARIS hors 0..8");
+    return;
+  }
+  fEdges = BuildParisEdges(parisIndex);
+  SetBinsFromEdges();
+}
+
+void MyPrimaryGenerator::SetConeTarget(const G4String& target)
+{
+  if (target == "off") { fConeTarget = -1; return; }
+  if (target == "all") { fConeTarget = kNParis; return; }
+  const G4int idx = std::atoi(target.c_str());
+  if (idx < 0 || idx >= kNParis || target.find_first_not_of("0123456789") != std::string::npos) {
+    G4Exception("MyPrimaryGenerator::SetConeTarget","BadConeTarget", JustWarning,
+                "coneTarget : off, all ou index PARIS 0..8");
+    return;
+  }
+  fConeTarget = idx;
+}
+
+void MyPrimaryGenerator::SetFaceBeam(const G4String& target)
+{
+  if (target == "off") { fFaceBeam = -1; return; }
+  const G4int idx = std::atoi(target.c_str());
+  if (idx < 0 || idx >= kNParis || target.find_first_not_of("0123456789") != std::string::npos) {
+    G4Exception("MyPrimaryGenerator::SetFaceBeam","BadFaceBeam", JustWarning,
+                "faceBeam : off ou index PARIS 0..8");
+    return;
+  }
+  fFaceBeam = idx;
+}
+
+// Faces Ce et axes des PARIS, lus dans MyDetectorConstruction au premier évènement
+void MyPrimaryGenerator::LoadParisGeometry()
+{
+  if (fFaceCentresSet) return;
+  const auto* det = dynamic_cast<const MyDetectorConstruction*>(
+      G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  if (!det) return;
+  for (G4int idx = 0; idx < kNParis; ++idx) {
+    fFaceCentres[idx] = det->GetParisFaceCentre(idx);
+    fParisAxes[idx]   = det->GetParisAxis(idx);
+  }
+  fFaceCentresSet = true;
+}
+
+// Tous les primaires entrent dans le Ce par le centre de la face avant, sans
+// traverser le boîtier : population du modèle rapide (ParisFastSimModel::ModelTrigger)
+void MyPrimaryGenerator::EmitOnFace(G4Event* anEvent)
+{
+  LoadParisGeometry();
+  if (!fFaceCentresSet) return;
+  const G4ThreeVector axis = fParisAxes[fFaceBeam];
+  const G4ThreeVector pos  = fFaceCentres[fFaceBeam] - 1.*um*axis;
+
+  for (G4int iv = 0; iv < anEvent->GetNumberOfPrimaryVertex(); ++iv) {
+    G4PrimaryVertex* vertex = anEvent->GetPrimaryVertex(iv);
+    vertex->SetPosition(pos.x(), pos.y(), pos.z());
+    for (auto* p = vertex->GetPrimary(); p; p = p->GetNext()) p->SetMomentumDirection(axis);
+  }
+}
+
+// Direction uniforme dans le cône autour de (face Ce - vertex), pour chaque vertex.
+// Poids = densité isotrope / densité de tirage. En mode all la densité de tirage est
+// le mélange des neuf cônes : une direction couverte par n cônes a un poids
+// 9 * Ω / (4π n), ce qui reste exact si deux cônes voisins se recouvrent.
+void MyPrimaryGenerator::EmitIntoCone(G4Event* anEvent)
+{
+  LoadParisGeometry();
+  if (!fFaceCentresSet) return;
+
+  const G4bool all = (fConeTarget == kNParis);
+  const G4int target = all ? anEvent->GetEventID() % kNParis : fConeTarget;
+  const G4double cosMax = std::cos(fConeHalfAngle);
+  const G4double omega = twopi*(1.0 - cosMax);
+
+  for (G4int iv = 0; iv < anEvent->GetNumberOfPrimaryVertex(); ++iv) {
+    G4PrimaryVertex* vertex = anEvent->GetPrimaryVertex(iv);
+    const G4ThreeVector pos = vertex->GetPosition();
+    const G4ThreeVector axis = (fFaceCentres[target] - pos).unit();
+
+    const G4double cosTheta = 1.0 - G4UniformRand()*(1.0 - cosMax);
+    const G4double sinTheta = std::sqrt(std::max(0.0, 1.0 - cosTheta*cosTheta));
+    const G4double phi = twopi*G4UniformRand();
+    G4ThreeVector dir(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+    dir.rotateUz(axis);
+
+    G4int nCones = 1;
+    if (all) {
+      nCones = 0;
+      for (G4int idx = 0; idx < kNParis; ++idx) {
+        if (dir.dot((fFaceCentres[idx] - pos).unit()) >= cosMax) ++nCones;
+      }
+    }
+    fEventWeight = (all ? kNParis : 1) * omega / (4.0*pi*std::max(1, nCones));
+    vertex->SetWeight(fEventWeight);
+
+    for (auto* p = vertex->GetPrimary(); p; p = p->GetNext()) p->SetMomentumDirection(dir);
+  }
+}
+
+// Bords au milieu de deux centres ; les bins extrêmes sont symétriques
+void MyPrimaryGenerator::SetBinsFromCenters()
+{
+  const size_t n = fCenters.size();
+  fEdges.assign(n + 1, 0.0);
+  for (size_t i = 1; i < n; ++i) fEdges[i] = 0.5*(fCenters[i-1] + fCenters[i]);
+  if (n == 1) {
+    fEdges[0] = fEdges[1] = fCenters[0];
+    return;
+  }
+  fEdges[0] = std::max(0.0, fCenters[0] - (fEdges[1] - fCenters[0]));
+  fEdges[n] = fCenters[n-1] + (fCenters[n-1] - fEdges[n-1]);
+}
+
+void MyPrimaryGenerator::SetBinsFromEdges()
+{
+  fCenters.assign(fEdges.size() - 1, 0.0);
+  for (size_t i = 0; i + 1 < fEdges.size(); ++i) fCenters[i] = 0.5*(fEdges[i] + fEdges[i+1]);
+}
+
+// Même nombre d'évènements attendu par bin (comme un run par énergie)
+G4double MyPrimaryGenerator::SampleEnergy()
+{
+  const G4int n = (G4int)fCenters.size();
+  fTrueBin = std::min(n - 1, (G4int)(G4UniformRand()*n));
+  if (fEnergyMode == EnergyMode::Discrete) return fCenters[fTrueBin]*keV;
+
+  const G4double lo = fEdges[fTrueBin], hi = fEdges[fTrueBin + 1];
+  return (lo + G4UniformRand()*(hi - lo))*keV;
+}
+
 void MyPrimaryGenerator::GeneratePrimaries(G4Event* anEvent)
 {
   fGPS->GeneratePrimaryVertex(anEvent);
-}
\ No newline at end of file
+
+  // Mode scan : on remplace l'énergie des primaires générées par GPS
+  // (la source GPS est partagée entre threads, le G4PrimaryParticle non)
+  fTrueBin = -1;
+  fEventWeight = 1.0;
+  if (fFaceBeam >= 0)        EmitOnFace(anEvent);
+  else if (fConeTarget >= 0) EmitIntoCone(anEvent);
+
+  if (fEnergyMode != EnergyMode::GPS && !fCenters.empty()) {
+    const G4double e = SampleEnergy();
+    for (G4int iv = 0; iv < anEvent->GetNumberOfPrimaryVertex(); ++iv) {
+      for (auto* p = anEvent->GetPrimaryVertex(iv)->GetPrimary(); p; p = p->GetNext()) {
+        p->SetKineticEnergy(e);
+      }
+    }
+  }
+
+  // Énergie vraie mémorisée ici : l'EventAction n'a plus à parcourir
+  // les vertex ni à comparer des noms de particules
+  fTrueEnergy = 0.0;
+  const auto* gamma = G4Gamma::Definition();
+  for (G4int iv = 0; iv < anEvent->GetNumberOfPrimaryVertex(); ++iv) {
+    for (auto* p = anEvent->GetPrimaryVertex(iv)->GetPrimary(); p; p = p->GetNext()) {
+      if (p->GetParticleDefinition() == gamma) {
+        fTrueEnergy = p->GetKineticEnergy();
+        return;
+      }
+    }
+  }
+}
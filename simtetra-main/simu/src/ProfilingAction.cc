@@ -0,0 +1,133 @@
+#include "ProfilingAction.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4VProcess.hh"
+#include "G4Threading.hh"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+MyProfilingAction::MyProfilingAction()
+{
+    fMessenger = new G4GenericMessenger(this, "/tetra/profile/", "Profilage par volume / particule / processus");
+    fMessenger->DeclareProperty("sampling", fSampling,
+                                "Un pas chronométré sur N (temps estimé = somme x N)")
+              .SetRange("sampling>0");
+    if (G4Threading::IsMasterThread()) {
+        fMessenger->DeclareProperty("file", fCsvFile,
+                                    "Table complète (volume, particule, processus) en CSV, écrite par le master")
+                  .SetToBeBroadcasted(false);
+    }
+}
+
+MyProfilingAction::~MyProfilingAction() { delete fMessenger; }
+
+void MyProfilingAction::UserSteppingAction(const G4Step* step)
+{
+    const G4StepPoint* pre = step->GetPreStepPoint();
+    const G4VPhysicalVolume* pv = pre->GetPhysicalVolume();
+    const G4LogicalVolume* lv = pv ? pv->GetLogicalVolume() : nullptr;
+    const G4Track* track = step->GetTrack();
+    const G4ParticleDefinition* particle = track->GetDefinition();
+
+    Counts& c = fCounts[Key{lv, particle, step->GetPostStepPoint()->GetProcessDefinedStep()}];
+    ++c.steps;
+
+    // Nouvelle trace : volume de naissance, processus créateur (nullptr = primaire)
+    if (track->GetCurrentStepNumber() == 1) {
+        ++fCounts[Key{lv, particle, track->GetCreatorProcess()}].tracks;
+    }
+
+    // Temps : intervalle entre un pas marqué et le suivant, attribué au suivant
+    if (fMarked) {
+        const auto now = std::chrono::steady_clock::now();
+        c.seconds += fSampling * std::chrono::duration<G4double>(now - fMark).count();
+        fMarked = false;
+    } else if (++fStepCounter % fSampling == 0) {
+        fMark = std::chrono::steady_clock::now();
+        fMarked = true;
+    }
+}
+
+void MyProfilingAction::Flush()
+{
+    std::lock_guard<std::mutex> lock(fMergeMutex);
+    for (const auto& [key, counts] : fCounts) {
+        NamedKey name{key.volume   ? key.volume->GetName()       : G4String("OutOfWorld"),
+                      key.particle ? key.particle->GetParticleName() : G4String("?"),
+                      key.process  ? key.process->GetProcessName()   : G4String("primary")};
+        Counts& m = fMerged[name];
+        m.steps   += counts.steps;
+        m.tracks  += counts.tracks;
+        m.seconds += counts.seconds;
+    }
+    fCounts.clear();
+    fMarked = false;
+}
+
+namespace {
+  // Somme par une colonne de la clé, triée par temps décroissant
+  template <std::size_t I, class Map>
+  void PrintBy(const Map& merged, const char* title, G4double totalSeconds)
+  {
+    std::map<std::string, std::array<G4double, 3>> sums;   // pas, traces, temps
+    for (const auto& [key, c] : merged) {
+      auto& s = sums[std::get<I>(key)];
+      s[0] += c.steps; s[1] += c.tracks; s[2] += c.seconds;
+    }
+    std::vector<std::pair<std::string, std::array<G4double, 3>>> rows(sums.begin(), sums.end());
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) { return a.second[2] > b.second[2]; });
+
+    // Mise en forme dans un flux local : G4cout garde sa précision
+    std::ostringstream os;
+    os << "\n---- Profil par " << title << " ----\n"
+       << std::left << std::setw(28) << title << std::right
+       << std::setw(14) << "pas" << std::setw(12) << "traces"
+       << std::setw(12) << "temps [s]" << std::setw(8) << "%" << "\n";
+    const std::size_t nRows = std::min<std::size_t>(rows.size(), 20);
+    for (std::size_t i = 0; i < nRows; ++i) {
+      const auto& [name, s] = rows[i];
+      os << std::left << std::setw(28) << name << std::right
+         << std::setw(14) << (G4long)s[0] << std::setw(12) << (G4long)s[1]
+         << std::setw(12) << std::setprecision(4) << s[2]
+         << std::setw(8) << std::setprecision(3) << (totalSeconds > 0 ? 100.*s[2]/totalSeconds : 0.) << "\n";
+    }
+    if (rows.size() > nRows) os << "  (" << rows.size() - nRows << " autres, voir /tetra/profile/file)\n";
+    G4cout << os.str() << G4endl;
+  }
+}
+
+void MyProfilingAction::Report(G4int runID) const
+{
+    std::lock_guard<std::mutex> lock(fMergeMutex);
+    if (fMerged.empty()) return;
+
+    G4long steps = 0, tracks = 0;
+    G4double seconds = 0.0;
+    for (const auto& [key, c] : fMerged) { steps += c.steps; tracks += c.tracks; seconds += c.seconds; }
+    G4cout << "\n==== Profil du run " << runID << " : " << steps << " pas, " << tracks
+           << " traces, ~" << seconds << " s (tous threads) ====" << G4endl;
+
+    PrintBy<0>(fMerged, "volume", seconds);
+    PrintBy<1>(fMerged, "particule", seconds);
+    PrintBy<2>(fMerged, "processus", seconds);
+
+    if (!fCsvFile.empty()) {
+        std::ofstream csv(fCsvFile + "_run" + std::to_string(runID) + ".csv");
+        csv << "volume,particle,process,steps,tracks,seconds\n";
+        for (const auto& [key, c] : fMerged) {
+            csv << std::get<0>(key) << ',' << std::get<1>(key) << ',' << std::get<2>(key) << ','
+                << c.steps << ',' << c.tracks << ',' << c.seconds << '\n';
+        }
+        G4cout << ">>> Profil complet : " << fCsvFile << "_run" << runID << ".csv" << G4endl;
+    }
+    fMerged.clear();
+}
@@ -1,14 +1,24 @@
 // RunAction.cc
 #include "RunAction.hh"
 #include "EventAction.hh"
+#include "ParisResolution.hh"
+#include "PhysicsList.hh"
+#include "RunReport.hh"
+#include "ProfilingAction.hh"
+#include "ParisFastSimModel.hh"
 
 #include "G4AnalysisManager.hh"
+#include "G4AccumulableManager.hh"
 #include "G4Run.hh"
+#include "G4RunManagerKernel.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4Types.hh"
 #include "G4String.hh"
+#include "G4Threading.hh"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <ctime>
 
 MyRunAction::MyRunAction(const G4String& macroFileName)
@@ -17,9 +27,21 @@ MyRunAction::MyRunAction(const G4String& macroFileName)
 {
     auto* man = G4AnalysisManager::Instance();
 
+    fRespRawH2Id.fill(-1);
+    fRespSmearedH2Id.fill(-1);
+    fRespFineH2Id.fill(-1);
+    fGenH1Id.fill(-1);
+
     man->SetVerboseLevel(1);
     #ifdef G4MULTITHREADED
-    man->SetNtupleMerging(true);
+    // Par défaut les lignes des workers sont fusionnées par le master (un seul fichier).
+    // TETRA_NTUPLE_MERGING=0 : chaque worker écrit ses ntuples dans <sortie>_t<N>.root,
+    // sans passer par le master ; les lecteurs chaînent les fichiers (myanalyse/TetraChain.h).
+    // Lu ici (avant toute réservation) : une commande UI arriverait trop tard.
+    if (const char* env = std::getenv("TETRA_NTUPLE_MERGING"); env && std::string(env) == "0") {
+        fNtupleMerging = false;
+    }
+    man->SetNtupleMerging(fNtupleMerging);
     #endif
 
     // 0) Événements (comptes et énergies agrégées)
@@ -33,6 +55,7 @@ MyRunAction::MyRunAction(const G4String& macroFileName)
     man->CreateNtupleIColumn("HitsRing2");
     man->CreateNtupleIColumn("HitsRing3");
     man->CreateNtupleIColumn("HitsRing4");
+    man->CreateNtupleIColumn("runID");   // EventID repart de 0 à chaque run (scan : un fichier)
     man->FinishNtuple(); // index 0
 
     // 1) Hits triton (par entrée dans une cellule)
@@ -42,12 +65,14 @@ MyRunAction::MyRunAction(const G4String& macroFileName)
     man->CreateNtupleDColumn("y_mm");
     man->CreateNtupleDColumn("z_mm");
     man->CreateNtupleDColumn("time_ns");
+    man->CreateNtupleIColumn("runID");
     man->FinishNtuple(); // index 1
 
     // 2) Anneaux (un par hit triton)
     man->CreateNtuple("Rings","ring index");
     man->CreateNtupleIColumn("EventID");
     man->CreateNtupleIColumn("RingN");
+    man->CreateNtupleIColumn("runID");
     man->FinishNtuple(); // index 2
 
     // 3) Edep par détecteur (par copie)
@@ -56,6 +81,7 @@ MyRunAction::MyRunAction(const G4String& macroFileName)
     man->CreateNtupleIColumn("copy");     // copy number
     man->CreateNtupleDColumn("eCe_keV");
     man->CreateNtupleDColumn("eNaI_keV");
+    man->CreateNtupleIColumn("runID");
     man->FinishNtuple(); // index 3
 
     // 4) Ntuple Etrue/Emeas (matrice de réponse / migration)
@@ -66,6 +92,9 @@ MyRunAction::MyRunAction(const G4String& macroFileName)
     man->CreateNtupleDColumn(fTruthRespNtupleId, "Emeas_keV");    // énergie mesurée (smeared Ce)
     man->CreateNtupleDColumn(fTruthRespNtupleId, "EdepCe_keV");   // dépôt Ce (avant smearing)
     man->CreateNtupleDColumn(fTruthRespNtupleId, "EdepNaI_keV");  // dépôt NaI (optionnel)
+    man->CreateNtupleIColumn(fTruthRespNtupleId, "trueBin");      // bin tiré par /tetra/gen (-1 sinon)
+    man->CreateNtupleDColumn(fTruthRespNtupleId, "weight");       // poids d'émission en cône (1 sinon)
+    man->CreateNtupleIColumn(fTruthRespNtupleId, "runID");        // clé (runID, eventID) unique dans le fichier
     man->FinishNtuple();    // index 4
     // 5) Ntuple temps/énergie par crystal (à remplir plus tard)
     man->CreateNtuple("paris_time", "Edep + first time per PARIS");
@@ -75,10 +104,108 @@ MyRunAction::MyRunAction(const G4String& macroFileName)
     man->CreateNtupleDColumn("Enai_keV");
     man->CreateNtupleDColumn("tFirstCe_ns");
     man->CreateNtupleDColumn("tFirstNaI_ns");
+    man->CreateNtupleIColumn("runID");
     man->FinishNtuple(); // index 5
+
+    // 6) Métadonnées du run (une ligne par run, remplie par le master)
+    fRunMetaNtupleId = man->CreateNtuple("RunMeta", "events generated / rows written");
+    man->CreateNtupleIColumn(fRunMetaNtupleId, "runID");
+    man->CreateNtupleDColumn(fRunMetaNtupleId, "nEventsGenerated");
+    man->CreateNtupleDColumn(fRunMetaNtupleId, "nEventsWritten");
+    man->CreateNtupleDColumn(fRunMetaNtupleId, "nParisRowsWritten");
+    man->CreateNtupleDColumn(fRunMetaNtupleId, "nParisRowsSuppressed");
+    man->CreateNtupleIColumn(fRunMetaNtupleId, "sparse");
+    man->CreateNtupleDColumn(fRunMetaNtupleId, "threshold_keV");
+    man->CreateNtupleDColumn(fRunMetaNtupleId, "nKilledFragments");   // MyStackingAction
+    man->CreateNtupleDColumn(fRunMetaNtupleId, "nKilledNeutrons");
+    man->CreateNtupleDColumn(fRunMetaNtupleId, "nKilledNeutrinos");
+    man->CreateNtupleDColumn(fRunMetaNtupleId, "nKilledElectrons");
+    man->CreateNtupleDColumn(fRunMetaNtupleId, "scanEnergy_keV");     // /tetra/scan (0 sinon)
+    man->CreateNtupleIColumn(fRunMetaNtupleId, "nThreadFiles");       // ntuples par thread (0 = fusionnés)
+    man->CreateNtupleDColumn(fRunMetaNtupleId, "nFastSimPhotons");    // ParisFastSimModel (0 = tracking complet)
+    man->FinishNtuple(); // index 6
+
+    auto* acc = G4AccumulableManager::Instance();
+    acc->RegisterAccumulable(fNEventsGenerated);
+    acc->RegisterAccumulable(fNEventsWritten);
+    acc->RegisterAccumulable(fNParisRowsWritten);
+    acc->RegisterAccumulable(fNParisRowsSuppressed);
+    for (auto& n : fNKilled) acc->RegisterAccumulable(n);
+
+    fMessenger = new G4GenericMessenger(this, "/tetra/output/", "Contrôle de la sortie ntuple");
+    fMessenger->DeclareProperty("sparse", fSparseOutput,
+                                "N'écrire que les évènements / PARIS avec un dépôt au-dessus du seuil");
+    fMessenger->DeclarePropertyWithUnit("threshold", "keV", fSparseThreshold,
+                                        "Seuil (Ce + NaI) par PARIS en mode sparse");
+    fMessenger->DeclareProperty("ntuples", fNtupleOutput,
+                                "Écrire les ntuples par évènement (Events, ParisEdep, resp, paris_time)");
+    fMessenger->DeclareProperty("respHistos", fRespHistos,
+                                "Remplir les matrices de réponse H2 par PARIS (Emeas x Etrue)");
+    fMessenger->DeclareProperty("smearing", fSmearing,
+                                "Smearing gaussien Ce par évènement (false : Emeas = dépôt brut, repli par FoldResolution.C)");
+    fMessenger->DeclarePropertyWithUnit("fineBinWidth", "keV", fFineBinWidth,
+                                        "Largeur de la grille fine du dépôt Ce brut (hRespFine_*), 0 = pas d'histo");
+    fMessenger->DeclareProperty("fineDetector", fFineDetector,
+                                "Index (0..8) du PARIS scanné : seul hRespFine_<det> réservé (~13 Mo par thread à 10 keV)")
+              .SetRange("fineDetector>=-1 && fineDetector<=8");
+    fMessenger->DeclareProperty("stream", fStreamOutput,
+                                "Flux binaire des dépôts PARIS (<sortie>_t<N>.pstream, ParisStream.hh)");
+    fMessenger->DeclareProperty("compression", fCompressionLevel,
+                                "Niveau de compression zlib du fichier ROOT (0-9, -1 = défaut Geant4)")
+              .SetRange("compression>=-1 && compression<=9");
+    fMessenger->DeclareProperty("basketSize", fBasketSize,
+                                "Taille des baskets TTree en octets (0 = défaut Geant4, 32000)");
+    fMessenger->DeclareProperty("basketEntries", fBasketEntries,
+                                "Entrées par basket des colonnes (0 = défaut Geant4, 4000)");
+}
+
+// H2 par PARIS avec le binning résolution de MakeResponseForUnfolding.C
+// (mêmes bornes en X et Y), + H1 des énergies générées pour normaliser.
+// Fusionnés automatiquement entre threads en fin de run.
+// Chaque famille n'est réservée qu'une fois (au premier run où elle est demandée).
+void MyRunAction::BookResponseHistos()
+{
+    auto* man = G4AnalysisManager::Instance();
+
+    if (fFineBinWidth > 0.0 && fFineDetector < 0 && IsMaster()) {
+        G4Exception("MyRunAction::BookResponseHistos","NoFineDetector", JustWarning,
+                    "/tetra/output/fineBinWidth sans /tetra/output/fineDetector : pas de hRespFine_*");
+    }
+
+    for (G4int idx = 0; idx < kNParis; ++idx) {
+        const std::vector<G4double> edges = BuildParisEdges(idx);
+        const G4String det = kParisNames[idx];
+
+        if (fRespHistos && fRespRawH2Id[idx] < 0) {
+            fRespRawH2Id[idx] = man->CreateH2("hResp_" + det,
+                "Response (Ce brut) " + det + ";E_{meas} [keV];E_{true} [keV]", edges, edges);
+            fGenH1Id[idx] = man->CreateH1("hGen_" + det,
+                "Generated E_{true} " + det + ";E_{true} [keV]", edges);
+        }
+        if (fRespHistos && fSmearing && fRespSmearedH2Id[idx] < 0) {
+            fRespSmearedH2Id[idx] = man->CreateH2("hRespSmeared_" + det,
+                "Response (Ce smeared) " + det + ";E_{meas} [keV];E_{true} [keV]", edges, edges);
+        }
+
+        // Dépôt Ce brut sur grille fine (X) : à replier par FoldResolution.C.
+        // Un seul PARIS (celui du scan) : ~1500 x 156 bins par H2 et par thread.
+        // Ce nul (NaI seul) dans l'underflow en X, distinct des petits dépôts du bin 1.
+        if (fFineBinWidth > 0.0 && idx == fFineDetector && fRespFineH2Id[idx] < 0) {
+            const G4double width_keV = fFineBinWidth/keV;
+            const G4int nFine = (G4int)std::ceil(kFineEmax_keV/width_keV);
+            std::vector<G4double> fine(nFine + 1);
+            for (G4int i = 0; i <= nFine; ++i) fine[i] = i*width_keV;
+            fRespFineH2Id[idx] = man->CreateH2("hRespFine_" + det,
+                "Ce brut (grille fine) " + det + ";E_{dep,Ce} [keV];E_{true} [keV]", fine, edges);
+        }
+    }
 }
 
-MyRunAction::~MyRunAction() {}
+MyRunAction::~MyRunAction()
+{
+    delete fMessenger;
+    if (fOwnsProfiler) delete fProfiler;
+}
 
 static G4String StripPath(const G4String& s) {
   std::string ss = s;
@@ -97,34 +224,155 @@ static G4String StripExtension(const G4String& s, const G4String& ext = ".mac")
   return ss;
 }
 
-void MyRunAction::BeginOfRunAction(const G4Run* run)
+// Nom du fichier ROOT de sortie ; suffix = tranche /tetra/checkpoint ("_part<k>")
+G4String MyRunAction::OutputFileName(G4int runID, const G4String& suffix) const
 {
-    auto* man = G4AnalysisManager::Instance();
-
     // 1) Priorité au TAG (fourni par le script bash)
     if (const char* tag = std::getenv("TAG"); tag && *tag) {
-        G4String outFile = "../../myanalyse/output_" + G4String(tag) + ".root";
-        G4cout << ">>> Ouverture du fichier ROOT (via TAG): " << outFile << G4endl;
-        man->OpenFile(outFile);
-        return;
+        return "../../myanalyse/output_" + G4String(tag) + suffix + ".root";
     }
-
     // 2) Fallback: nommage basé sur le macro + runID
     G4String base = fMacroName;               // ex: "run_0.mac"
     if (base.empty()) base = "interactive.mac";
     base = StripPath(base);                   // "run_0.mac"
     base = StripExtension(base, ".mac");      // "run_0"
 
+    // En tranches, le runID repart de 0 après reprise : seul _part<k> distingue les fichiers
     std::stringstream tag2;
-    tag2 << "_run" << run->GetRunID();        // _run0, _run1, ...
+    if (suffix.empty()) tag2 << "_run" << runID;   // _run0, _run1, ...
 
-    G4String outFile = "../../myanalyse/BerceaunewGeo" + base + tag2.str() + "_smeared.root";
-    G4cout << ">>> Ouverture du fichier ROOT (fallback): " << outFile << G4endl;
+    return "../../myanalyse/BerceaunewGeo" + base + tag2.str() + "_smeared" + suffix + ".root";
+}
+
+void MyRunAction::BeginOfRunAction(const G4Run* run)
+{
+    auto* man = G4AnalysisManager::Instance();
+
+    // Master : les tables physiques viennent d'être construites (warm start)
+    if (IsMaster()) {
+        if (auto* phys = dynamic_cast<MyPhysicsList*>(
+                G4RunManagerKernel::GetRunManagerKernel()->GetPhysicsList())) {
+            phys->StoreTableCache();
+        }
+    }
+
+    // Chronométrage et progression (MyRunReport) ; le master démarre avant les workers
+    fRunStart     = std::chrono::steady_clock::now();
+    fThreadEvents = 0;
+    if (IsMaster()) {
+        fEventsToProcess = run->GetNumberOfEventToBeProcessed();
+        fEventsDoneAll   = 0;
+    }
+    const G4double progress = MyRunReport::ProgressInterval();
+    fNextProgress = (progress > 0.0)
+        ? fRunStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                          std::chrono::duration<G4double>(progress))
+        : std::chrono::steady_clock::time_point::max();
+
+    G4AccumulableManager::Instance()->Reset();
+    BookResponseHistos();
+    if (fEventAction) fEventAction->BeginOfRun();
+
+    // Scan en énergie : fichier déjà ouvert par le premier run du scan
+    if (fFileOpened) return;
+    fFileOpened = true;
+
+    const G4String outFile = OutputFileName(run->GetRunID(), fOutputSuffix);
+    G4cout << ">>> Ouverture du fichier ROOT : " << outFile << G4endl;
+    // Réglages pris en compte à l'ouverture du fichier (commandes déjà diffusées aux workers)
+    if (fCompressionLevel >= 0) man->SetCompressionLevel(fCompressionLevel);
+    if (fBasketSize > 0)        man->SetBasketSize(fBasketSize);
+    if (fBasketEntries > 0)     man->SetBasketEntries(fBasketEntries);
     man->OpenFile(outFile);
+    fOutFileName = outFile;
+
+    // Flux binaire : un fichier par thread qui traite des évènements
+    if (fStreamOutput && (!IsMaster() || !G4Threading::IsMultithreadedApplication())) {
+        std::stringstream streamFile;
+        streamFile << StripExtension(outFile, ".root");
+        if (G4Threading::G4GetThreadId() >= 0) streamFile << "_t" << G4Threading::G4GetThreadId();
+        streamFile << ".pstream";
+        if (!fStream.Open(streamFile.str())) {
+            G4Exception("MyRunAction::BeginOfRunAction","StreamOpenFailed", JustWarning,
+                        ("Impossible d'ouvrir " + streamFile.str()).c_str());
+        }
+    }
 }
-void MyRunAction::EndOfRunAction(const G4Run*)
+void MyRunAction::EndOfRunAction(const G4Run* run)
 {
     auto* man = G4AnalysisManager::Instance();
-    man->Write();
-    man->CloseFile();
+
+    G4AccumulableManager::Instance()->Merge();
+    if (IsMaster()) {
+        // Ici les compteurs contiennent la somme de tous les workers
+        man->FillNtupleIColumn(fRunMetaNtupleId, 0, run->GetRunID());
+        man->FillNtupleDColumn(fRunMetaNtupleId, 1, (G4double)fNEventsGenerated.GetValue());
+        man->FillNtupleDColumn(fRunMetaNtupleId, 2, (G4double)fNEventsWritten.GetValue());
+        man->FillNtupleDColumn(fRunMetaNtupleId, 3, (G4double)fNParisRowsWritten.GetValue());
+        man->FillNtupleDColumn(fRunMetaNtupleId, 4, (G4double)fNParisRowsSuppressed.GetValue());
+        man->FillNtupleIColumn(fRunMetaNtupleId, 5, fSparseOutput ? 1 : 0);
+        man->FillNtupleDColumn(fRunMetaNtupleId, 6, fSparseThreshold/keV);
+        for (G4int k = 0; k < kNStackKill; ++k) {
+            man->FillNtupleDColumn(fRunMetaNtupleId, 7 + k, (G4double)fNKilled[k].GetValue());
+        }
+        man->FillNtupleDColumn(fRunMetaNtupleId, 7 + kNStackKill, fScanEnergy/keV);
+        man->FillNtupleIColumn(fRunMetaNtupleId, 8 + kNStackKill,
+                               fNtupleMerging ? 0 : G4Threading::GetNumberOfRunningWorkerThreads());
+        const G4long nFastSim = ParisFastSimModel::TakeNFired();
+        man->FillNtupleDColumn(fRunMetaNtupleId, 9 + kNStackKill, (G4double)nFastSim);
+        man->AddNtupleRow(fRunMetaNtupleId);
+
+        G4cout << ">>> Run " << run->GetRunID()
+               << " : " << fNEventsGenerated.GetValue() << " evts générés, "
+               << fNEventsWritten.GetValue() << " écrits, "
+               << fNParisRowsSuppressed.GetValue() << " lignes PARIS supprimées"
+               << (fSparseOutput ? " (sparse)" : "") << G4endl;
+        G4cout << ">>> Traces tuées à la mise en pile : "
+               << fNKilled[(G4int)StackKill::Fragment].GetValue() << " fragments, "
+               << fNKilled[(G4int)StackKill::Neutron].GetValue()  << " neutrons, "
+               << fNKilled[(G4int)StackKill::Neutrino].GetValue() << " neutrinos, "
+               << fNKilled[(G4int)StackKill::Electron].GetValue() << " électrons" << G4endl;
+        if (nFastSim > 0) {
+            G4cout << ">>> Fast-sim PARIS : " << nFastSim << " photons paramétrés" << G4endl;
+        }
+    }
+
+    // Scan : histogrammes et ntuples s'accumulent jusqu'au dernier run
+    if (!fKeepFileOpen) {
+        man->Write();
+        man->CloseFile();
+        fStream.Close();
+        fFileOpened = false;
+    }
+
+    // Profilage : tables des threads fusionnées, affichées par le master
+    if (fProfiler) fProfiler->Flush();
+    if (fProfiler && IsMaster()) fProfiler->Report(run->GetRunID());
+
+    // Rapport : threads qui traitent des évènements, puis le master (après les workers)
+    const G4double seconds = std::chrono::duration<G4double>(std::chrono::steady_clock::now() - fRunStart).count();
+    if (auto* report = MyRunReport::Instance()) {
+        if (!IsMaster() || !G4Threading::IsMultithreadedApplication()) {
+            report->AddThreadRun(G4Threading::G4GetThreadId(), fThreadEvents, seconds);
+        }
+        if (IsMaster()) report->AddRun(run->GetRunID(), run->GetNumberOfEvent(), seconds, fOutFileName);
+    }
+}
+
+// Une ligne par thread et par intervalle : débit du thread, avancement et ETA du run
+void MyRunAction::PrintProgress()
+{
+    const auto now = std::chrono::steady_clock::now();
+    fNextProgress = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                              std::chrono::duration<G4double>(MyRunReport::ProgressInterval()));
+
+    const G4double elapsed = std::chrono::duration<G4double>(now - fRunStart).count();
+    const G4long   done    = fEventsDoneAll;
+    const G4long   total   = fEventsToProcess;
+    const G4double rateAll = (elapsed > 0.0) ? done / elapsed : 0.0;
+    std::ostringstream os;
+    os << ">>> [t" << G4Threading::G4GetThreadId() << "] " << fThreadEvents << " evts ("
+       << (elapsed > 0.0 ? fThreadEvents / elapsed : 0.0) << " evt/s) ; run " << done << "/" << total;
+    if (rateAll > 0.0 && total > done) os << ", ETA ~" << (total - done) / rateAll << " s";
+    G4cout << os.str() << G4endl;
 }
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "RunReport.hh"
+
+#include "G4StateManager.hh"
+#include "G4Threading.hh"
+#include "G4Version.hh"
+
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sys/resource.h>
+
+MyRunReport::MyRunReport()
+{
+    fInstance = this;
+
+    if (const char* env = std::getenv("TETRA_RUN_REPORT"); env) {
+        fFileName = env;
+    } else if (const char* tag = std::getenv("TAG"); tag && *tag) {
+        fFileName = "report_" + G4String(tag) + ".json";
+    } else {
+        fFileName = "simTetra_report.json";
+    }
+
+    fMessenger = new G4GenericMessenger(this, "/tetra/report/", "Progression et rapport JSON de fin de job");
+    fMessenger->DeclareProperty("file", fFileName,
+                                "Fichier JSON écrit à la sortie (vide = pas de rapport)")
+              .SetToBeBroadcasted(false);
+    fMessenger->DeclareMethod("progressInterval", &MyRunReport::SetProgressInterval,
+                              "Secondes entre deux lignes de progression par thread (0 = aucune)")
+              .SetToBeBroadcasted(false);
+}
+
+MyRunReport::~MyRunReport()
+{
+    delete fMessenger;
+    fInstance = nullptr;
+}
+
+G4bool MyRunReport::Notify(G4ApplicationState requestedState)
+{
+    const G4ApplicationState current = G4StateManager::GetStateManager()->GetCurrentState();
+    if (requestedState == G4State_Init && current != G4State_Init) {
+        fInitStart = std::chrono::steady_clock::now();
+    } else if (current == G4State_Init && requestedState == G4State_Idle) {
+        fInitSeconds += std::chrono::duration<G4double>(std::chrono::steady_clock::now() - fInitStart).count();
+    }
+    return true;
+}
+
+void MyRunReport::AddThreadRun(G4int threadID, G4long nEvents, G4double seconds)
+{
+    std::lock_guard<std::mutex> lock(fMutex);
+    fPendingThreads.push_back({threadID, nEvents, seconds});
+}
+
+void MyRunReport::AddRun(G4int runID, G4long nEvents, G4double seconds, const G4String& outFile)
+{
+    RunEntry entry;
+    entry.runID   = runID;
+    entry.nEvents = nEvents;
+    entry.seconds = seconds;
+    entry.bytes   = OutputBytes(outFile);
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    entry.threads.swap(fPendingThreads);
+    fRuns.push_back(std::move(entry));
+}
+
+// Fichier du run + fichiers par thread (<base>_t<N>.root, ntuples non fusionnés)
+// + flux binaires (<base>[_t<N>].pstream)
+G4long MyRunReport::OutputBytes(const G4String& outFile)
+{
+    namespace fs = std::filesystem;
+    if (outFile.empty()) return 0;
+    const fs::path path(std::string(outFile));
+    const std::string stem = path.stem().string();
+
+    std::error_code ec;
+    G4long bytes = 0;
+    const fs::path dir = path.has_parent_path() ? path.parent_path() : fs::path(".");
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        const std::string ext  = entry.path().extension().string();
+        const std::string name = entry.path().stem().string();
+        if (ext != ".root" && ext != ".pstream") continue;
+        if (name.compare(0, stem.size(), stem) != 0) continue;
+
+        // exactement <base> ou <base>_t<chiffres>
+        const std::string rest = name.substr(stem.size());
+        G4bool match = rest.empty();
+        if (rest.size() > 2 && rest.compare(0, 2, "_t") == 0) {
+            match = true;
+            for (std::size_t i = 2; i < rest.size(); ++i) match = match && std::isdigit((unsigned char)rest[i]);
+        }
+        if (match) bytes += static_cast<G4long>(entry.file_size(ec));
+    }
+    return bytes;
+}
+
+void MyRunReport::Write(G4double wall_s, G4double cpu_s) const
+{
+    if (fFileName.empty()) return;
+
+    struct rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);   // ru_maxrss en kiB (Linux)
+
+    std::lock_guard<std::mutex> lock(fMutex);
+    std::ofstream out(fFileName);
+    if (!out) {
+        G4cerr << "Rapport de run : impossible d'écrire " << fFileName << G4endl;
+        return;
+    }
+    out << std::setprecision(6);
+    out << "{\n"
+        << "  \"geant4\": " << G4VERSION_NUMBER << ",\n"
+        << "  \"threads\": " << G4Threading::GetNumberOfRunningWorkerThreads() << ",\n"
+        << "  \"wall_s\": " << wall_s << ",\n"
+        << "  \"cpu_s\": " << cpu_s << ",\n"
+        << "  \"init_s\": " << fInitSeconds << ",\n"
+        << "  \"peak_rss_kB\": " << usage.ru_maxrss << ",\n"
+        << "  \"runs\": [";
+    for (std::size_t r = 0; r < fRuns.size(); ++r) {
+        const RunEntry& run = fRuns[r];
+        out << (r ? "," : "") << "\n    {\"runID\": " << run.runID
+            << ", \"events\": " << run.nEvents
+            << ", \"seconds\": " << run.seconds
+            << ", \"events_per_s\": " << (run.seconds > 0 ? run.nEvents / run.seconds : 0.0)
+            << ", \"output_bytes\": " << run.bytes
+            << ",\n     \"threads\": [";
+        for (std::size_t t = 0; t < run.threads.size(); ++t) {
+            const ThreadRun& th = run.threads[t];
+            out << (t ? ", " : "") << "{\"thread\": " << th.threadID
+                << ", \"events\": " << th.nEvents
+                << ", \"seconds\": " << th.seconds
+                << ", \"events_per_s\": " << (th.seconds > 0 ? th.nEvents / th.seconds : 0.0) << "}";
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+
+    G4cout << ">>> Rapport de run : " << fFileName << G4endl;
+}
@@ -0,0 +1,76 @@
+#include "ScanDriver.hh"
+#include "PrimaryGenerator.hh"
+#include "RunAction.hh"
+
+#include "G4RunManager.hh"
+#include "G4UImanager.hh"
+#include "G4UIcommandStatus.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <chrono>
+#include <sstream>
+
+MyScanDriver::MyScanDriver()
+{
+    fMessenger = new G4GenericMessenger(this, "/tetra/scan/", "Scan en énergie dans un seul processus");
+    fMessenger->DeclareMethod("energyList", &MyScanDriver::LoadEnergyList,
+                              "Énergies du scan (keV) : /control/alias Elist { ... } ou une valeur par ligne");
+    fMessenger->DeclareProperty("eventsPerEnergy", fEventsPerEnergy,
+                                "Nombre d'évènements par énergie (/run/beamOn)");
+    fMessenger->DeclareProperty("energyCommand", fEnergyCommand,
+                                "Commande recevant '<E> keV' avant chaque run (défaut /gps/ene/mono)");
+    fMessenger->DeclareMethod("start", &MyScanDriver::Start,
+                              "Lance le scan (après /run/initialize et la configuration de la source)");
+}
+
+MyScanDriver::~MyScanDriver() { delete fMessenger; }
+
+void MyScanDriver::LoadEnergyList(G4String fileName)
+{
+    fEnergies = MyPrimaryGenerator::ReadEnergyList(fileName);
+    G4cout << ">>> /tetra/scan : " << fEnergies.size() << " énergies lues dans " << fileName << G4endl;
+}
+
+void MyScanDriver::Start()
+{
+    auto* runManager = G4RunManager::GetRunManager();
+    auto* ui = G4UImanager::GetUIpointer();
+    if (fEnergies.empty() || fEventsPerEnergy <= 0) {
+        G4Exception("MyScanDriver::Start","EmptyScan", JustWarning,
+                    "Scan vide : /tetra/scan/energyList et eventsPerEnergy > 0 requis");
+        return;
+    }
+
+    auto energyCommand = [this](G4double e_keV) {
+        std::ostringstream cmd;
+        cmd << fEnergyCommand << ' ' << e_keV << " keV";
+        return cmd.str();
+    };
+    // Vérifiée avant le premier run : un arrêt en cours de scan laisserait le fichier ouvert
+    if (ui->ApplyCommand(energyCommand(fEnergies.front())) != fCommandSucceeded) {
+        G4Exception("MyScanDriver::Start","ScanEnergyCommand", JustWarning,
+                    ("Commande refusée : " + energyCommand(fEnergies.front())).c_str());
+        return;
+    }
+
+    const std::size_t n = fEnergies.size();
+    const auto t0 = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const G4double e_keV = fEnergies[i];
+        ui->ApplyCommand(energyCommand(e_keV));
+
+        // Fichier ouvert au premier run, écrit et fermé au dernier
+        MyRunAction::SetScanState(i + 1 < n, e_keV*keV);
+        runManager->BeamOn(fEventsPerEnergy);
+
+        const G4double elapsed = std::chrono::duration<G4double>(std::chrono::steady_clock::now() - t0).count();
+        const G4double eta = elapsed / (i + 1) * (n - i - 1);
+        G4cout << ">>> [scan] " << i + 1 << "/" << n << "  E = " << e_keV << " keV"
+               << "  (" << fEventsPerEnergy << " evts)  écoulé " << elapsed << " s"
+               << ", restant ~" << eta << " s" << G4endl;
+    }
+
+    // Hors scan : les runs suivants retrouvent le comportement habituel
+    MyRunAction::SetScanState(false, 0.0);
+}
@@ -0,0 +1,73 @@
+#include "StackingAction.hh"
+#include "RunAction.hh"
+
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Electron.hh"
+#include "G4Neutron.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+
+#include <cstdlib>
+
+MyStackingAction::MyStackingAction(MyRunAction* runAction)
+: fRunAction(runAction)
+{
+    fMessenger = new G4GenericMessenger(this, "/tetra/stack/", "Élagage des traces à la mise en pile");
+    fMessenger->DeclareProperty("killFragments", fKillFragments,
+                                "Tuer les fragments de fission et noyaux lourds secondaires (A > 4)");
+    fMessenger->DeclareProperty("killNeutrons", fKillNeutrons,
+                                "Tuer les neutrons secondaires (gammas PARIS seuls)");
+    fMessenger->DeclareProperty("killNeutrinos", fKillNeutrinos,
+                                "Tuer les neutrinos");
+    fMessenger->DeclarePropertyWithUnit("electronCut", "keV", fElectronCut,
+                                        "Tuer les e- sous ce seuil nés hors volume sensible (0 = jamais)");
+    fMessenger->DeclareMethod("preset", &MyStackingAction::SetPreset,
+                              "Réglage par type de run : gammaResponse | cf252Paris | none")
+              .SetCandidates("gammaResponse cf252Paris none");
+}
+
+MyStackingAction::~MyStackingAction() { delete fMessenger; }
+
+void MyStackingAction::SetPreset(G4String preset)
+{
+    // gammaResponse : rien d'autre que les gammas et leurs électrons n'atteint les PARIS
+    // cf252Paris    : gammas prompts seuls, neutrons et fragments inutiles
+    const G4bool cf = (preset == "cf252Paris");
+    const G4bool on = cf || preset == "gammaResponse";
+    fKillFragments = cf;
+    fKillNeutrons  = cf;
+    fKillNeutrinos = on;
+    fElectronCut   = on ? 100.*keV : 0.;
+}
+
+G4ClassificationOfNewTrack MyStackingAction::ClassifyNewTrack(const G4Track* track)
+{
+    if (track->GetParentID() == 0) return fUrgent;
+
+    const G4ParticleDefinition* def = track->GetDefinition();
+    const G4int pdg = std::abs(def->GetPDGEncoding());
+    G4int kill = -1;
+
+    if (fKillNeutrinos && (pdg == 12 || pdg == 14 || pdg == 16)) {
+        kill = static_cast<G4int>(StackKill::Neutrino);
+    }
+    else if (fKillNeutrons && def == G4Neutron::Definition()) {
+        kill = static_cast<G4int>(StackKill::Neutron);
+    }
+    else if (fKillFragments && def->GetParticleType() == "nucleus" && def->GetBaryonNumber() > 4) {
+        kill = static_cast<G4int>(StackKill::Fragment);
+    }
+    else if (fElectronCut > 0. && def == G4Electron::Definition()
+             && track->GetKineticEnergy() < fElectronCut) {
+        // Volume de naissance (touchable du parent) : gardé si sensible (Ce, NaI, He3)
+        const G4VPhysicalVolume* pv = track->GetVolume();
+        if (pv && !pv->GetLogicalVolume()->GetSensitiveDetector()) {
+            kill = static_cast<G4int>(StackKill::Electron);
+        }
+    }
+
+    if (kill < 0) return fUrgent;
+    if (fRunAction) fRunAction->CountKilledTrack(kill);
+    return fKill;
+}